@@ -3,9 +3,9 @@
 
 layout(location = 0) out vec4 color;
 
-uniform vec2 u_Resolution;
 uniform vec4 u_BaseColor;  // Base color for the tile (sci-fi style)
-uniform float u_Time;      // Animation over time for added effect
+
+#include "includes/frame.shader"
 
 // Function to create a grid pattern
 float gridPattern(vec2 uv, float gridSize) {
@@ -2,16 +2,22 @@
 #version 330 core
 
 layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec4 bandColor;
 
-uniform mat4 u_MVP;
+#include "includes/frame.shader"
 
 out vec2 vWorldPosition; // Pass to fragment shader
+out vec4 vColor;
+out vec4 vBandColor;
 
 
 void main()
 {
-    gl_Position = u_MVP * vec4(position, 0.0, 1.0);
+    gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
     vWorldPosition = position;
+    vColor = color;
+    vBandColor = bandColor;
 }
 
 #shader fragment
@@ -19,17 +25,16 @@ void main()
 
 layout(location = 0) out vec4 color;
 in vec2 vWorldPosition; // Received from vertex shader
+in vec4 vColor;
+in vec4 vBandColor;
 
-uniform vec4 u_Color;
-uniform vec4 u_BandColor;
-uniform vec2 uPlayerPosition; 
-
+#include "includes/frame.shader"
 #include "includes/lab.shader"
 
 void main()
 {
-    float distance = length(vWorldPosition - uPlayerPosition);
+    float distance = length(vWorldPosition - u_PlayerPosition);
 
     float intensity = 1.0 / (1.0 + ((distance * distance) / 15));
-    color = mix(u_Color, u_BandColor, intensity);
+    color = mix(vColor, vBandColor, intensity);
 }
@@ -0,0 +1,10 @@
+// Per-frame values shared by every shader, filled in once per frame by Renderer::BeginFrame (see
+// Renderer::FrameUniforms for the C++ side of this std140 layout)
+layout(std140) uniform FrameData {
+    mat4  u_ViewProjection;
+    mat4  u_InverseViewProjection;
+    vec2  u_Resolution;     // framebuffer size in pixels
+    vec2  u_PlayerPosition; // world space
+    float u_Time;           // seconds since GLFW was initialised
+    float u_StartTime;
+};
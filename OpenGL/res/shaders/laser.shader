@@ -9,7 +9,7 @@ uniform vec2 u_StartPos;       // Start position of the line
 uniform vec2 u_EndPos;         // End position of the line
 uniform float u_Width;         // Width of the line
 
-uniform mat4 u_MVP;            // Model-View-Projection matrix
+#include "includes/frame.shader"
 
 // Output to Fragment Shader
 out float v_WidthFactor;       // Factor to determine fragment's position relative to center
@@ -31,8 +31,8 @@ void main()
     // Apply the offset to get the final position
     vec2 finalPos = interpolatedPos + offset;
     
-    // Transform the final position using the MVP matrix
-    gl_Position = u_MVP * vec4(finalPos, 0.0, 1.0);
+    // Transform the final position to clip space (the line is already in world space)
+    gl_Position = u_ViewProjection * vec4(finalPos, 0.0, 1.0);
     
     // Pass the absolute value of y position to fragment shader for gradient
     v_WidthFactor = abs(a_Position.y);
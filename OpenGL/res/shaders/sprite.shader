@@ -0,0 +1,38 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 tint;
+
+out vec2 v_TexCoord;
+out vec4 v_Tint;
+
+#include "includes/frame.shader"
+
+void main()
+{
+    gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+    v_TexCoord = texCoord;
+    v_Tint = tint;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+in vec2 v_TexCoord;
+in vec4 v_Tint;
+uniform sampler2D u_Texture;
+
+#include "includes/lab.shader"
+
+void main()
+{
+    vec4 texColor = texture(u_Texture, v_TexCoord);
+    vec3 texColor_lab = rgb2lab(texColor.rgb);
+    vec3 inputColor_lab = rgb2lab(v_Tint.rgb);
+    
+    vec3 color_lab = mix(texColor_lab, inputColor_lab, v_Tint.a);
+    color = vec4(lab2rgb(color_lab), texColor.a);
+}
@@ -11,8 +11,7 @@ void main()
 #shader fragment
 #version 330 core
 layout(location = 0) out vec4 color;
-uniform float u_Time;
-uniform vec2 u_Resolution;
+#include "includes/frame.shader"
 
 float random(vec2 coord)
 {
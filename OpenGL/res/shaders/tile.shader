@@ -0,0 +1,42 @@
+#shader vertex
+#version 330 core
+
+// shared quad
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+// per tile
+layout(location = 2) in vec2 tilePosition;
+layout(location = 3) in vec4 uvRect;
+layout(location = 4) in vec4 tint;
+
+out vec2 v_TexCoord;
+out vec4 v_Tint;
+
+uniform mat4 u_MVP;
+
+void main()
+{
+    gl_Position = u_MVP * vec4(tilePosition + position, 0.0, 1.0);
+    v_TexCoord = mix(uvRect.xy, uvRect.zw, texCoord);
+    v_Tint = tint;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+in vec2 v_TexCoord;
+in vec4 v_Tint;
+uniform sampler2D u_Texture;
+
+#include "includes/lab.shader"
+
+void main()
+{
+    vec4 texColor = texture(u_Texture, v_TexCoord);
+    vec3 texColor_lab = rgb2lab(texColor.rgb);
+    vec3 inputColor_lab = rgb2lab(v_Tint.rgb);
+    
+    vec3 color_lab = mix(texColor_lab, inputColor_lab, v_Tint.a);
+    color = vec4(lab2rgb(color_lab), texColor.a);
+}
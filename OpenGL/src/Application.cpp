@@ -1,6 +1,3 @@
-#define MINIAUDIO_IMPLEMENTATION
-#include "miniaudio.h"
-
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <algorithm>
@@ -10,9 +7,9 @@
 #include <string>
 #include <sstream>
 #include <set>
+#include <random>
 
-#define STB_IMAGE_IMPLEMENTATION // for icon
-#include "stb_image.h"
+#include "stb_image.h" // for icon
 
 #include "Renderer.h"
 #include "VertexBuffer.h"
@@ -29,6 +26,10 @@
 #include "game_objects/Tile.h"
 #include "game_objects/enemies/Bomber.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
+#include "AssetLoader.h"
+#include "FixedClock.h"
+#include "InputRecording.h"
 #include "game_objects/Fog.h"
 
 #include "imgui.h"
@@ -62,9 +63,18 @@ void key_callback(GLFWwindow* window, int key, int /* scancode */, int action, i
    }
 }
 
-int main(void) {
+// usage: SpaceBoom [--record <file>]
+//    --record  write the input of the session to <file>, to play it back with SpaceBoomReplay
+int main(int argc, char** argv) {
+
+   const std::string MAP = "maps/SpaceShip.txt";
 
-   const float TICKS_PER_SECOND = 3.0f;
+   std::string recordPath;
+   for (int i = 1; i + 1 < argc; i++) {
+      if (std::string(argv[i]) == "--record") {
+         recordPath = argv[++i];
+      }
+   }
 
    /* Initialize the library */
    if (!glfwInit())
@@ -102,6 +112,9 @@ int main(void) {
 
    std::cout << "current version of GL: " << glGetString(GL_VERSION) << std::endl;
 
+   // Decodes textures and reads fonts in the background while the renderer, atlas and map are set up
+   AssetLoader::Start();
+
    GLCall(glEnable(GL_BLEND));
    GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
 
@@ -117,58 +130,69 @@ int main(void) {
 
    Renderer renderer(window, &io);
 
-   World::LoadMap("maps/SpaceShip.txt");
-   World::gameobjects.push_back(std::make_unique<Fog>());
+   // Pack all sprites into one texture so batches don't have to switch textures
+   TextureAtlas::Build(Renderer::ResPath() + "textures/");
 
-   Input::currentTime       = glfwGetTime();
-   double realTimeLastFrame = Input::currentTime;
-   double lastTick          = Input::startTime;
+   uint32_t seed = std::random_device{}();
+   World::rng.seed(seed);
+   std::unique_ptr<InputRecorder> recorder;
+   if (!recordPath.empty()) {
+      recorder = std::make_unique<InputRecorder>(recordPath, MAP, seed);
+   }
+
+   World::LoadMap(MAP);
+   World::AddObject(std::make_shared<Fog>());
+
+   // Game time starts at the same point in every session, so a replay sees the same clock
+   Input::currentTime = Input::startTime;
+   Input::deltaTime   = (float)FixedClock::STEP;
+
+   double     realTimeLastFrame = glfwGetTime();
+   FixedClock clock;
+   bool       firstFrame        = true;
    audio().Song.play();
 
    // -------------------
    // Main rendering loop
    // -------------------
    while (!glfwWindowShouldClose(window)) {
-      double lastFrameTime = Input::currentTime;
-      Input::deltaTime     = World::timeSpeed * (glfwGetTime() - realTimeLastFrame);
-      Input::currentTime   = Input::currentTime + Input::deltaTime;
-      realTimeLastFrame    = glfwGetTime();
-      if (!World::settingTimeSpeed) {
-         World::timeSpeed = zeno(World::timeSpeed, 1.0, 0.4);
-         audio().Update(World::timeSpeed);
-
-      } else {
-         World::settingTimeSpeed = false;
-      }
-
-      // Set the viewport size
-      auto [width, height] = renderer.WindowSize();
-      glViewport(0, 0, (GLsizei)width, (GLsizei)height);
-
-      auto gameobjects = World::get_gameobjects();
+      double now = glfwGetTime();
+      clock.Advance(World::timeSpeed * (now - realTimeLastFrame));
+      realTimeLastFrame = now;
 
       renderer.Clear();
-      Input::updateKeyStates(window);
-
-      World::UpdateObjects();
-
-      if (!World::ticksPaused()) {
-         if (World::shouldTick) {
-            World::TickObjects();
-            lastTick          = Input::currentTime;
-            World::shouldTick = false;
-         } else if (lastTick + (1.0 / TICKS_PER_SECOND) <= Input::currentTime) {
-            World::TickObjects();
-            lastTick = lastTick + (1.0 / TICKS_PER_SECOND);
+
+      // Objects update at a fixed step however long the frame took
+      bool firstStep = true;
+      while (clock.Step()) {
+         if (firstStep) {
+            Input::updateKeyStates(window);
+            Input::mouseWorldPosition = renderer.MousePos();
+            firstStep                 = false;
+         } else {
+            Input::clearPressedDown();
+         }
+         if (recorder) {
+            recorder->RecordStep();
          }
+         World::Step();
       }
+      audio().Update(World::timeSpeed);
 
       // Start the Dear ImGui frame
       ImGui_ImplOpenGL3_NewFrame();
       ImGui_ImplGlfw_NewFrame();
       ImGui::NewFrame();
 
+      // Camera and player have moved for this frame; capture them once for everything drawn below, part of the way
+      // from the previous step to the latest
+      auto player = World::getFirst<Player>();
+      renderer.BeginFrame(player ? player->renderPosition(clock.Interpolation()) : glm::vec2(0.0f),
+                          clock.Interpolation());
+
       // Render all objects
+      renderer.sprites.ResetStats();
+      renderer.tiles.ResetStats();
       World::RenderObjects(renderer);
 
       // Render debug lines
@@ -179,6 +203,14 @@ int main(void) {
          ImGui::PushFont(renderer.jacquard12_small);
          ImGui::Begin("Performance Info");
          ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+         ImGui::Text("%u objects on screen, %u culled", World::renderedObjects, World::culledObjects);
+         ImGui::Text("%u sprites in %u draw calls", renderer.sprites.spritesDrawn, renderer.sprites.drawCalls);
+         ImGui::Text("%u tile chunks drawn, %u re-rendered, %u tiles uploaded, %u draw calls",
+                     renderer.tiles.chunksDrawn, renderer.tiles.chunksRendered, renderer.tiles.tilesUploaded,
+                     renderer.tiles.drawCalls);
+         if (World::streamer.Active()) {
+            ImGui::Text("%u of %u map chunks loaded", World::streamer.LoadedChunks(), World::streamer.TotalChunks());
+         }
          ImGui::End();
          ImGui::PopFont();
       }
@@ -190,10 +222,22 @@ int main(void) {
       // Swap front and back buffers
       glfwSwapBuffers(window);
 
+      // Every shader the opening scene needs has been created by now
+      if (firstFrame) {
+         Shader::LogSetupStats();
+         firstFrame = false;
+      }
+
       // Poll for and process events
       glfwPollEvents();
    }
 
+   if (recorder) {
+      recorder->Finish(World::StateHash());
+   }
+
+   AssetLoader::Stop();
+
    // Cleanup ImGui
    ImGui_ImplOpenGL3_Shutdown();
    ImGui_ImplGlfw_Shutdown();
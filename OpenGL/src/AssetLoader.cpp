@@ -0,0 +1,127 @@
+#include "AssetLoader.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+struct WorkerPool {
+   std::mutex                        mutex;
+   std::condition_variable           wake;
+   std::deque<std::function<void()>> jobs;
+   std::vector<std::thread>          threads;
+   bool                              stopping = false;
+
+   // A static pool still holding threads when main returns would std::terminate; stop them on every exit path
+   ~WorkerPool() { stop(); }
+
+   void stop() {
+      {
+         std::lock_guard lock(mutex);
+         stopping = true;
+      }
+      wake.notify_all();
+      // Workers drain the queue before exiting so no future is left without a value
+      for (auto& thread : threads) {
+         thread.join();
+      }
+      threads.clear();
+   }
+
+   void run() {
+      // Texture flips its images on load; the flag is per thread so workers set their own
+      stbi_set_flip_vertically_on_load_thread(1);
+      while (true) {
+         std::function<void()> job;
+         {
+            std::unique_lock lock(mutex);
+            wake.wait(lock, [&] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+               return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+         }
+         job();
+      }
+   }
+};
+
+WorkerPool& pool() {
+   static WorkerPool pool;
+   return pool;
+}
+
+} // namespace
+
+void AssetLoader::Start(unsigned workers) {
+   auto& p = pool();
+   if (!p.threads.empty()) {
+      return;
+   }
+   if (workers == 0) {
+      // hardware_concurrency() may be 0 when it can't be determined
+      unsigned hardwareThreads = std::thread::hardware_concurrency();
+      workers                  = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+   }
+   p.stopping = false;
+   for (unsigned i = 0; i < workers; i++) {
+      p.threads.emplace_back([&p] { p.run(); });
+   }
+   std::cout << "Asset loader started with " << workers << " workers" << std::endl;
+}
+
+void AssetLoader::Stop() {
+   pool().stop();
+}
+
+void AssetLoader::Enqueue(std::function<void()> job) {
+   auto& p = pool();
+   {
+      std::unique_lock lock(p.mutex);
+      if (!p.threads.empty() && !p.stopping) {
+         p.jobs.push_back(std::move(job));
+         lock.unlock();
+         p.wake.notify_one();
+         return;
+      }
+   }
+   job();
+}
+
+std::shared_future<std::shared_ptr<const DecodedImage>> AssetLoader::DecodeImage(const std::string& path) {
+   return Submit([path]() -> std::shared_ptr<const DecodedImage> {
+      auto image  = std::make_shared<DecodedImage>();
+      image->path = path;
+      int            bpp;
+      // inline jobs run on the caller's thread, whose flag may not be set yet
+      stbi_set_flip_vertically_on_load_thread(1);
+      unsigned char* pixels = stbi_load(path.c_str(), &image->width, &image->height, &bpp, 4);
+      if (!pixels) {
+         std::cerr << "Failed to load texture: " << path << std::endl;
+         return image;
+      }
+      image->pixels.assign(pixels, pixels + (size_t)image->width * image->height * 4);
+      stbi_image_free(pixels);
+      return image;
+   });
+}
+
+std::shared_future<std::shared_ptr<const std::vector<char>>> AssetLoader::ReadFile(const std::string& path) {
+   return Submit([path]() -> std::shared_ptr<const std::vector<char>> {
+      std::ifstream file(path, std::ios::binary);
+      if (!file.is_open()) {
+         std::cerr << "Failed to open " << path << std::endl;
+         return std::make_shared<std::vector<char>>();
+      }
+      return std::make_shared<std::vector<char>>(std::istreambuf_iterator<char>(file),
+                                                 std::istreambuf_iterator<char>());
+   });
+}
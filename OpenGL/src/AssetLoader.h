@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// RGBA8 pixels decoded by stb_image, flipped like Texture expects. Empty pixels if the file couldn't be read.
+struct DecodedImage {
+   std::string                path;
+   int                        width  = 0;
+   int                        height = 0;
+   std::vector<unsigned char> pixels;
+
+   bool ok() const { return !pixels.empty(); }
+};
+
+// Runs file reads and image decodes on worker threads so startup isn't serialised on the disk and on stb_image.
+// Everything comes back as a shared_future; whatever needs GL (texture upload, font atlas) is finished on the main
+// thread by whoever holds the future, once it is ready. Before Start (and in the headless tools, which never start
+// it) jobs run inline on the calling thread.
+class AssetLoader {
+public:
+   // 0 workers means one per hardware thread, leaving one for the main thread
+   static void Start(unsigned workers = 0);
+   // Waits for the queued jobs and joins the workers. Also done when the program exits without calling it.
+   static void Stop();
+
+   template <typename F>
+   static std::shared_future<std::invoke_result_t<F>> Submit(F&& job) {
+      using Result = std::invoke_result_t<F>;
+      auto task    = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+      std::shared_future<Result> future = task->get_future().share();
+      Enqueue([task] { (*task)(); });
+      return future;
+   }
+
+   static std::shared_future<std::shared_ptr<const DecodedImage>> DecodeImage(const std::string& path);
+   static std::shared_future<std::shared_ptr<const std::vector<char>>> ReadFile(const std::string& path);
+
+   // True if the future has its value, without blocking
+   template <typename T>
+   static bool IsReady(const std::shared_future<T>& future) {
+      return future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+   }
+
+private:
+   static void Enqueue(std::function<void()> job);
+};
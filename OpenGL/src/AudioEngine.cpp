@@ -1,3 +1,6 @@
+#define MINIAUDIO_IMPLEMENTATION
+#include "miniaudio.h"
+
 #include "AudioEngine.h"
 #include "Renderer.h"
 #include <cstring>
@@ -5,9 +8,14 @@
 
 Sound::Sound(const std::string& filename, ma_engine* engine)
    : engine(engine) {
-   ma_result result = ma_sound_init_from_file(engine, filename.c_str(), MA_SOUND_FLAG_STREAM, NULL, NULL, &sound);
+   // ASYNC hands the file open and first decode to miniaudio's resource manager thread, so the 13 sounds don't hold up
+   // startup; a sound played before it is ready just starts late
+   ma_result result = ma_sound_init_from_file(engine, filename.c_str(), MA_SOUND_FLAG_STREAM | MA_SOUND_FLAG_ASYNC,
+                                              NULL, NULL, &sound);
    if (result != MA_SUCCESS) {
       std::cout << "Failed to load sound - " << result << std::endl;
+      // never touch a sound that failed to initialize
+      this->engine = nullptr;
    }
 }
 
@@ -51,6 +59,22 @@ Sound::~Sound() {
 }
 
 
+MiniAudioEngine::MiniAudioEngine() {
+   ma_engine_config config = ma_engine_config_init();
+   if (World::headless) {
+      // No playback device in headless runs; the engine still has to know its output format.
+      config.noDevice   = MA_TRUE;
+      config.channels   = 2;
+      config.sampleRate = 48000;
+   }
+
+   ma_result result = ma_engine_init(&config, &engine);
+   if (result != MA_SUCCESS) {
+      std::cout << "Failed to initialize audio engine - " << result << std::endl;
+   }
+}
+
+
 AudioEngine::AudioEngine()
    : Walk(getSound("walk1.wav"))
    , Walk1(getSound("walk2.wav"))
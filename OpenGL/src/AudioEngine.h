@@ -25,14 +25,7 @@ public:
 class MiniAudioEngine {
 public:
    ma_engine engine;
-   MiniAudioEngine() {
-      ma_result result;
-
-      result = ma_engine_init(NULL, &engine);
-      if (result != MA_SUCCESS) {
-         std::cout << "Failed to initialize audio engine - " << result << std::endl;
-      }
-   }
+   MiniAudioEngine();
 };
 
 class AudioEngine {
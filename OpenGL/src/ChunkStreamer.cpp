@@ -0,0 +1,161 @@
+#include "ChunkStreamer.h"
+#include "World.h"
+#include "DangerField.h"
+#include "game_objects/Bomb.h"
+#include "game_objects/Tile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+namespace {
+
+int floorDiv(int value, int divisor) {
+   return value / divisor - (value % divisor < 0 ? 1 : 0);
+}
+
+// Reach of a tick beyond the tile an object stands on, which has to stay inside the neighbouring chunks
+static_assert(Bomb::BLAST_RADIUS <= ChunkStreamer::CHUNK_SIZE, "blasts must not reach past the neighbouring chunks");
+static_assert(DangerField::BULLET_RANGE <= ChunkStreamer::CHUNK_SIZE,
+              "bullet danger must not reach past the neighbouring chunks");
+
+} // namespace
+
+void ChunkStreamer::Load(const MapView& map) {
+   Clear();
+   origin  = {map.header.originX, map.header.originY};
+   columns = ((int)map.header.width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   rows    = ((int)map.header.height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+   chunks.resize((size_t)columns * rows);
+
+   for (int cy = 0; cy < rows; cy++) {
+      for (int cx = 0; cx < columns; cx++) {
+         auto& chunk = At(cx, cy);
+         chunk.tiles.assign(CHUNK_SIZE * CHUNK_SIZE, TileKind::Empty);
+         for (int y = 0; y < CHUNK_SIZE; y++) {
+            uint32_t row = (uint32_t)(cy * CHUNK_SIZE + y);
+            if (row >= map.header.height) {
+               break;
+            }
+            uint32_t first = (uint32_t)(cx * CHUNK_SIZE);
+            uint32_t count = std::min<uint32_t>(CHUNK_SIZE, map.header.width - first);
+            std::copy_n(&map.tiles[(size_t)row * map.header.width + first], count,
+                        &chunk.tiles[(size_t)y * CHUNK_SIZE]);
+         }
+      }
+   }
+}
+
+void ChunkStreamer::Clear() {
+   chunks.clear();
+   loaded.clear();
+   columns      = 0;
+   rows         = 0;
+   centerChunk  = glm::ivec2(INT32_MIN);
+   loadedChunks = 0;
+}
+
+glm::ivec2 ChunkStreamer::ChunkOf(int tile_x, int tile_y) const {
+   return {floorDiv(tile_x - origin.x, CHUNK_SIZE), floorDiv(tile_y - origin.y, CHUNK_SIZE)};
+}
+
+bool ChunkStreamer::IsSimulated(int tile_x, int tile_y) const {
+   if (!Active()) {
+      return true;
+   }
+   glm::ivec2 chunk = ChunkOf(tile_x, tile_y);
+   if (chunk.x < 0 || chunk.y < 0 || chunk.x >= columns || chunk.y >= rows) {
+      return false;
+   }
+   return chunks[(size_t)chunk.y * columns + chunk.x].simulated;
+}
+
+void ChunkStreamer::UpdateSimulated() {
+   for (glm::ivec2 chunk : loaded) {
+      bool simulated = true;
+      for (int cy = std::max(0, chunk.y - 1); cy <= std::min(rows - 1, chunk.y + 1); cy++) {
+         for (int cx = std::max(0, chunk.x - 1); cx <= std::min(columns - 1, chunk.x + 1); cx++) {
+            simulated &= At(cx, cy).loaded;
+         }
+      }
+      At(chunk.x, chunk.y).simulated = simulated;
+   }
+}
+
+void ChunkStreamer::Update(glm::vec2 center) {
+   glm::ivec2 current = ChunkOf((int)std::round(center.x), (int)std::round(center.y));
+   if (current == centerChunk) {
+      return;
+   }
+   centerChunk = current;
+
+   auto distance = [&](glm::ivec2 chunk) {
+      return std::max(std::abs(chunk.x - current.x), std::abs(chunk.y - current.y));
+   };
+
+   std::erase_if(loaded, [&](glm::ivec2 chunk) {
+      if (distance(chunk) <= unloadRadius) {
+         return false;
+      }
+      UnloadChunk(chunk.x, chunk.y);
+      return true;
+   });
+
+   for (int cy = std::max(0, current.y - loadRadius); cy <= std::min(rows - 1, current.y + loadRadius); cy++) {
+      for (int cx = std::max(0, current.x - loadRadius); cx <= std::min(columns - 1, current.x + loadRadius); cx++) {
+         if (!At(cx, cy).loaded) {
+            LoadChunk(cx, cy);
+            loaded.push_back({cx, cy});
+         }
+      }
+   }
+   UpdateSimulated();
+}
+
+void ChunkStreamer::LoadChunk(int cx, int cy) {
+   auto& chunk  = At(cx, cy);
+   chunk.loaded = true;
+   loadedChunks++;
+
+   for (int y = 0; y < CHUNK_SIZE; y++) {
+      for (int x = 0; x < CHUNK_SIZE; x++) {
+         float tile_x = (float)(origin.x + cx * CHUNK_SIZE + x);
+         float tile_y = (float)(origin.y + cy * CHUNK_SIZE + y);
+         switch (chunk.tiles[(size_t)y * CHUNK_SIZE + x]) {
+         case TileKind::Floor: World::AddObject(std::make_shared<Tile>(Tile("Floor", tile_x, tile_y))); break;
+         case TileKind::Wall:
+            World::AddObject(std::make_shared<Tile>(Tile("Wall", true, false, tile_x, tile_y)));
+            World::wallChanges.Push({(int)tile_x, (int)tile_y});
+            break;
+         case TileKind::UnbreakableWall:
+            World::AddObject(std::make_shared<Tile>(Tile("Wall", true, true, tile_x, tile_y)));
+            World::wallChanges.Push({(int)tile_x, (int)tile_y});
+            break;
+         case TileKind::Empty: break;
+         }
+      }
+   }
+}
+
+void ChunkStreamer::UnloadChunk(int cx, int cy) {
+   auto& chunk     = At(cx, cy);
+   chunk.loaded    = false;
+   chunk.simulated = false;
+   loadedChunks--;
+
+   for (int y = 0; y < CHUNK_SIZE; y++) {
+      for (int x = 0; x < CHUNK_SIZE; x++) {
+         int tile_x = origin.x + cx * CHUNK_SIZE + x;
+         int tile_y = origin.y + cy * CHUNK_SIZE + y;
+         for (auto* tile : World::at<Tile>(tile_x, tile_y)) {
+            // Write back what the tile is now, so walls that were blown up stay open
+            auto& kind = chunk.tiles[(size_t)y * CHUNK_SIZE + x];
+            kind       = !tile->wall ? TileKind::Floor : tile->unbreakable ? TileKind::UnbreakableWall : TileKind::Wall;
+            if (tile->wall) {
+               World::wallChanges.Push({tile_x, tile_y});
+            }
+            tile->ShouldDestroy = true;
+         }
+      }
+   }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "MapFile.h"
+
+// Chunked world mode for maps too large to keep as objects. The streamer keeps the whole tile layer as one TileKind
+// byte per tile and only turns the chunks around the player into Tile objects; chunks that fall behind are written
+// back to bytes (keeping walls that were blown up) and their tiles destroyed. Everything else on the map is spawned
+// as usual, but World only updates and ticks SquareObjects in simulated chunks: loaded chunks whose neighbours are all
+// loaded too. Nothing an object does in a tick reaches further than a chunk (a move, a bullet step, a blast), so the
+// simulated ones never run into streamed-out space, and enemies further out stay frozen until the player comes back.
+class ChunkStreamer {
+public:
+   // Side length of a chunk in tiles
+   static constexpr int CHUNK_SIZE = 16;
+
+   // Chunks within loadRadius (in chunks, Chebyshev distance) of the player are loaded; loaded ones are only unloaded
+   // once they are further than unloadRadius, so walking along a chunk border doesn't reload it every step
+   int loadRadius   = 3;
+   int unloadRadius = 4;
+
+   // Takes over the map's tiles. Nothing is spawned until the first Update.
+   void Load(const MapView& map);
+   void Clear();
+   bool Active() const { return !chunks.empty(); }
+
+   // Loads and unloads chunks around `center`. Called by World::UpdateObjects.
+   void Update(glm::vec2 center);
+   // Whether objects on this tile are updated and ticked. Always true when the streamer isn't active.
+   bool IsSimulated(int tile_x, int tile_y) const;
+
+   // Stats
+   uint32_t LoadedChunks() const { return loadedChunks; }
+   uint32_t TotalChunks() const { return (uint32_t)chunks.size(); }
+
+private:
+   struct Chunk {
+      std::vector<TileKind> tiles; // CHUNK_SIZE * CHUNK_SIZE, row-major
+      bool                  loaded    = false;
+      bool                  simulated = false; // loaded, and so are all its neighbours
+   };
+
+   void LoadChunk(int cx, int cy);
+   void UpdateSimulated();
+   void UnloadChunk(int cx, int cy);
+   // Chunk coordinate of a tile, relative to the map origin
+   glm::ivec2 ChunkOf(int tile_x, int tile_y) const;
+   Chunk&     At(int cx, int cy) { return chunks[(size_t)cy * columns + cx]; }
+
+   std::vector<Chunk>      chunks;
+   std::vector<glm::ivec2> loaded; // chunk coordinates of the loaded chunks
+   int                     columns      = 0;
+   int                     rows         = 0;
+   glm::ivec2              origin       = glm::ivec2(0);
+   glm::ivec2              centerChunk  = glm::ivec2(INT32_MIN);
+   uint32_t                loadedChunks = 0;
+};
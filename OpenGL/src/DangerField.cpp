@@ -0,0 +1,61 @@
+#include "DangerField.h"
+#include "World.h"
+#include "game_objects/Bomb.h"
+#include "game_objects/Bullet.h"
+#include "game_objects/Tile.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+bool isWall(int x, int y) {
+   auto tiles = World::at<Tile>(x, y);
+   return std::any_of(tiles.begin(), tiles.end(), [](const Tile* tile) { return tile->wall; });
+}
+
+} // namespace
+
+uint64_t DangerField::Key(int x, int y) {
+   return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void DangerField::Stamp(int x, int y, int ticks) {
+   auto  value = (uint8_t)std::clamp(ticks, 0, SAFE - 1);
+   auto& cell  = cells.try_emplace(Key(x, y), SAFE).first->second;
+   cell        = std::min(cell, value);
+}
+
+uint8_t DangerField::TicksUntilHit(int x, int y) const {
+   auto it = cells.find(Key(x, y));
+   return it == cells.end() ? SAFE : it->second;
+}
+
+void DangerField::Build() {
+   cells.clear();
+
+   for (auto* bomb : World::getAll<Bomb>()) {
+      // Bomb::tickUpdate explodes on the tick ExplodeTick passes FUSE_TICKS
+      int ticks = Bomb::FUSE_TICKS + 1 - bomb->ExplodeTick;
+      for (int dx = -Bomb::BLAST_RADIUS + 1; dx < Bomb::BLAST_RADIUS; dx++) {
+         int reach = Bomb::BLAST_RADIUS - 1 - std::abs(dx);
+         for (int dy = -reach; dy <= reach; dy++) {
+            Stamp(bomb->tile_x + dx, bomb->tile_y + dy, ticks);
+         }
+      }
+   }
+
+   for (auto* bullet : World::getAll<Bullet>()) {
+      if (bullet->direction_x == 0 && bullet->direction_y == 0) {
+         continue;
+      }
+      for (int step = 0; step <= BULLET_RANGE; step++) {
+         int x = bullet->tile_x + bullet->direction_x * step;
+         int y = bullet->tile_y + bullet->direction_y * step;
+         if (isWall(x, y)) {
+            break;
+         }
+         Stamp(x, y, step);
+      }
+   }
+}
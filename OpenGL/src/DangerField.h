@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+// Tiles that a bomb blast or a bullet will hit soon, shared by every enemy. World rebuilds it at the start of every
+// tick from the bombs (mines included: an unarmed mine is stamped as if it had just been triggered) and the straight
+// path of each bullet, so enemies look tiles up instead of searching for bombs and bullets around them.
+class DangerField {
+public:
+   static constexpr uint8_t SAFE = UINT8_MAX;
+   // How far ahead a bullet's path is stamped
+   static constexpr int BULLET_RANGE = 8;
+
+   void Build();
+   void Clear() { cells.clear(); }
+
+   // Ticks until (x, y) is hit (0 = this tick), or SAFE
+   uint8_t TicksUntilHit(int x, int y) const;
+   bool    IsDangerous(int x, int y) const { return TicksUntilHit(x, y) != SAFE; }
+
+private:
+   static uint64_t Key(int x, int y);
+   void            Stamp(int x, int y, int ticks);
+
+   std::unordered_map<uint64_t, uint8_t> cells;
+};
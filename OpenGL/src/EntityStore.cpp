@@ -0,0 +1,76 @@
+#include "EntityStore.h"
+#include "game_objects/GameObject.h"
+
+#include <algorithm>
+
+EntityHandle EntityStore::Insert(GameObject* object) {
+   uint32_t index;
+   if (!freeSlots.empty()) {
+      index = freeSlots.back();
+      freeSlots.pop_back();
+   } else {
+      index = (uint32_t)slots.size();
+      slots.emplace_back();
+   }
+
+   auto& kind             = kinds[std::type_index(typeid(*object))];
+   slots[index].object    = object;
+   slots[index].kindIndex = (uint32_t)kind.size();
+   slots[index].sequence  = nextSequence++;
+   kind.push_back(object);
+
+   return {index, slots[index].generation};
+}
+
+void EntityStore::Remove(EntityHandle handle) {
+   GameObject* object = Get(handle);
+   if (!object) {
+      return;
+   }
+
+   std::type_index type(typeid(*object));
+   auto&           kind = kinds[type];
+   if (std::find(kindsWithGaps.begin(), kindsWithGaps.end(), type) == kindsWithGaps.end()) {
+      kindsWithGaps.push_back(type);
+   }
+   kind[slots[handle.index].kindIndex] = nullptr;
+
+   slots[handle.index].object = nullptr;
+   slots[handle.index].generation++;
+   freeSlots.push_back(handle.index);
+}
+
+void EntityStore::Compact() {
+   for (auto type : kindsWithGaps) {
+      auto& kind = kinds[type];
+      std::erase(kind, nullptr);
+      for (uint32_t i = 0; i < kind.size(); i++) {
+         slots[kind[i]->handle.index].kindIndex = i;
+      }
+   }
+   kindsWithGaps.clear();
+}
+
+void EntityStore::Clear() {
+   freeSlots.clear();
+   for (uint32_t i = 0; i < slots.size(); i++) {
+      if (slots[i].object) {
+         slots[i].object = nullptr;
+         slots[i].generation++;
+      }
+      freeSlots.push_back(i);
+   }
+   kinds.clear();
+   kindsWithGaps.clear();
+}
+
+GameObject* EntityStore::Get(EntityHandle handle) const {
+   if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) {
+      return nullptr;
+   }
+   return slots[handle.index].object;
+}
+
+uint64_t EntityStore::Sequence(const GameObject* object) const {
+   return slots[object->handle.index].sequence;
+}
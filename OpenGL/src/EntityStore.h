@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+// Refers to an object in the World without owning it. Unlike a raw pointer it can be checked for staleness: once the
+// object is removed (or the map is reloaded) the handle resolves to nullptr, even if its slot has been reused.
+struct EntityHandle {
+   uint32_t index      = UINT32_MAX;
+   uint32_t generation = 0;
+
+   bool valid() const { return index != UINT32_MAX; }
+   bool operator==(const EntityHandle&) const = default;
+};
+
+// Hands out EntityHandles for the objects in the World and indexes them by concrete type, so queries for one kind of
+// object only walk that kind's list instead of dynamic_casting every object in the world. The lists hold pointers; the
+// objects themselves stay separate allocations owned by World::gameobjects, with their state in their own members.
+// Each list is kept in insertion order, so queries see objects in the same order as World::gameobjects.
+class EntityStore {
+public:
+   EntityHandle Insert(GameObject* object);
+   // Invalidates the handle at once; the object leaves its kind's list at the next Compact
+   void         Remove(EntityHandle handle);
+   // Closes the gaps Remove left in the kind lists, keeping their order. Once per batch of removals, so removing many
+   // objects of a large kind (a streamed out chunk of tiles) stays linear.
+   void         Compact();
+   // Invalidates every handle handed out so far
+   void         Clear();
+
+   GameObject* Get(EntityHandle handle) const;
+   // Position of a live object in insertion order, for merging the lists of several kinds
+   uint64_t    Sequence(const GameObject* object) const;
+
+   // Pointers to the objects of each concrete type (typeid of the most derived class), in insertion order
+   const std::unordered_map<std::type_index, std::vector<GameObject*>>& Kinds() const { return kinds; }
+
+private:
+   struct Slot {
+      GameObject* object     = nullptr;
+      uint32_t    generation = 0;
+      uint32_t    kindIndex  = 0; // position in kinds[typeid(*object)]
+      uint64_t    sequence   = 0;
+   };
+
+   std::vector<Slot>                                             slots;
+   std::vector<uint32_t>                                         freeSlots;
+   std::unordered_map<std::type_index, std::vector<GameObject*>> kinds;
+   std::vector<std::type_index>                                  kindsWithGaps;
+   uint64_t                                                      nextSequence = 0;
+};
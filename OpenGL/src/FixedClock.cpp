@@ -0,0 +1,21 @@
+#include "FixedClock.h"
+
+#include <cmath>
+
+void FixedClock::Advance(double seconds) {
+   accumulator    += seconds;
+   stepsThisFrame  = 0;
+}
+
+bool FixedClock::Step() {
+   if (accumulator < STEP) {
+      return false;
+   }
+   if (stepsThisFrame == MAX_STEPS_PER_FRAME) {
+      accumulator = std::fmod(accumulator, STEP);
+      return false;
+   }
+   accumulator -= STEP;
+   stepsThisFrame++;
+   return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// Fixed-step simulation clock. Frame time goes into an accumulator and comes back out as whole steps of STEP seconds,
+// so the game advances by the same amount per update however fast or slow frames are drawn. What is left over is the
+// fraction of a step the frame is drawn at, see Interpolation.
+class FixedClock {
+public:
+   static constexpr int    STEPS_PER_SECOND = 60;
+   static constexpr double STEP             = 1.0 / STEPS_PER_SECOND;
+   // After a long stall (a breakpoint, dragging the window) the backlog is dropped rather than simulated all at once
+   static constexpr int MAX_STEPS_PER_FRAME = 8;
+
+   // Adds `seconds` of game time for the frame about to be drawn
+   void  Advance(double seconds);
+   // Takes one step off the accumulator; false once the frame is caught up
+   bool  Step();
+   // How far between the previous step and the latest one the frame is, in [0, 1)
+   float Interpolation() const { return (float)(accumulator / STEP); }
+
+private:
+   double accumulator    = 0.0;
+   int    stepsThisFrame = 0;
+};
@@ -0,0 +1,99 @@
+#include "FlowField.h"
+#include "World.h"
+#include "game_objects/Tile.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+const glm::ivec2 NEIGHBOURS[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+// Only floor counts: a cell without any tile is outside the map
+bool isWalkable(int x, int y) {
+   auto tiles = World::at<Tile>(x, y);
+   return !tiles.empty() && std::none_of(tiles.begin(), tiles.end(), [](const Tile* tile) { return tile->wall; });
+}
+
+} // namespace
+
+FlowField::FlowField()
+   : wallChanges(World::wallChanges.AddReader()) {}
+
+FlowField::~FlowField() {
+   World::wallChanges.RemoveReader(wallChanges);
+}
+
+int FlowField::Index(int x, int y) const {
+   int localX = x - target.x + RADIUS;
+   int localY = y - target.y + RADIUS;
+   if (localX < 0 || localY < 0 || localX >= SIZE || localY >= SIZE) {
+      return -1;
+   }
+   return localY * SIZE + localX;
+}
+
+void FlowField::Build(glm::ivec2 newTarget) {
+   if (newTarget == target && mapVersion == World::mapVersion && !World::wallChanges.HasUnread(wallChanges)) {
+      return;
+   }
+   target     = newTarget;
+   mapVersion = World::mapVersion;
+   // The whole window is searched again, so which walls changed doesn't matter
+   World::wallChanges.Read(wallChanges);
+
+   std::fill(distances.begin(), distances.end(), UNREACHABLE);
+   queue.clear();
+   int start        = Index(target.x, target.y);
+   distances[start] = 0;
+   queue.push_back(start);
+
+   for (size_t head = 0; head < queue.size(); head++) {
+      int      index    = queue[head];
+      uint16_t distance = distances[index];
+      int      x        = index % SIZE + target.x - RADIUS;
+      int      y        = index / SIZE + target.y - RADIUS;
+      for (auto neighbour : NEIGHBOURS) {
+         int next = Index(x + neighbour.x, y + neighbour.y);
+         if (next < 0 || distances[next] != UNREACHABLE || !isWalkable(x + neighbour.x, y + neighbour.y)) {
+            continue;
+         }
+         distances[next] = distance + 1;
+         queue.push_back(next);
+      }
+   }
+}
+
+void FlowField::Clear() {
+   std::fill(distances.begin(), distances.end(), UNREACHABLE);
+   target = glm::ivec2(INT32_MIN);
+}
+
+uint16_t FlowField::Distance(int x, int y) const {
+   int index = Index(x, y);
+   return index < 0 ? UNREACHABLE : distances[index];
+}
+
+glm::ivec2 FlowField::NextStep(int x, int y) const {
+   uint16_t   best = Distance(x, y);
+   glm::ivec2 step(0);
+   if (best == UNREACHABLE) {
+      return step;
+   }
+   // Ties go to the step towards the target on the axis with the larger gap, which keeps paths close to the straight
+   // line like the old greedy chase
+   int        dx      = target.x > x ? 1 : -1;
+   int        dy      = target.y > y ? 1 : -1;
+   glm::ivec2 order[] = {{dx, 0}, {0, dy}, {-dx, 0}, {0, -dy}};
+   if (std::abs(target.y - y) > std::abs(target.x - x)) {
+      std::swap(order[0], order[1]);
+   }
+   for (auto neighbour : order) {
+      uint16_t distance = Distance(x + neighbour.x, y + neighbour.y);
+      if (distance < best) {
+         best = distance;
+         step = neighbour;
+      }
+   }
+   return step;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "WallChangeLog.h"
+
+// Walking distance to the player over the tile grid, shared by every enemy. A breadth-first search from the player's
+// tile through floor tiles, limited to a square window of RADIUS tiles around it, so building it costs the same no
+// matter how large the map is or how many enemies read it. World rebuilds it at the start of every tick, and skips
+// that when neither the player nor any wall has changed since the last build.
+class FlowField {
+public:
+   static constexpr int      RADIUS      = 24;
+   static constexpr uint16_t UNREACHABLE = UINT16_MAX;
+
+   FlowField();
+   ~FlowField();
+   FlowField(const FlowField&)            = delete;
+   FlowField& operator=(const FlowField&) = delete;
+
+   void Build(glm::ivec2 target);
+   void Clear();
+
+   // Steps from (x, y) to the target, or UNREACHABLE if it is walled off or outside the window
+   uint16_t   Distance(int x, int y) const;
+   // Unit step towards the target along a shortest path, or (0, 0) if there is none (or (x, y) is the target)
+   glm::ivec2 NextStep(int x, int y) const;
+
+private:
+   static constexpr int SIZE = 2 * RADIUS + 1;
+
+   int Index(int x, int y) const;
+
+   std::vector<uint16_t> distances = std::vector<uint16_t>(SIZE * SIZE, UNREACHABLE);
+   std::vector<int>      queue;
+   glm::ivec2            target     = glm::ivec2(INT32_MIN);
+   uint32_t              mapVersion = UINT32_MAX;
+   WallChangeLog::Reader wallChanges; // registered with World::wallChanges for the field's lifetime
+};
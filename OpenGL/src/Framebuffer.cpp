@@ -0,0 +1,44 @@
+#include "Framebuffer.h"
+
+#include <iostream>
+
+Framebuffer::Framebuffer(int width, int height)
+   : m_RendererID(0)
+   , m_TextureID(0)
+   , m_Width(width)
+   , m_Height(height) {
+   GLCall(glGenTextures(1, &m_TextureID));
+   GLCall(glBindTexture(GL_TEXTURE_2D, m_TextureID));
+   GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+   GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+   GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+   GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+   GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+   GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+
+   GLCall(glGenFramebuffers(1, &m_RendererID));
+   GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+   GLCall(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_TextureID, 0));
+   if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+      std::cerr << "Framebuffer " << m_Width << "x" << m_Height << " is incomplete" << std::endl;
+   }
+   GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+Framebuffer::~Framebuffer() {
+   if (m_RendererID != 0) {
+      GLCall(glDeleteFramebuffers(1, &m_RendererID));
+   }
+   if (m_TextureID != 0) {
+      GLCall(glDeleteTextures(1, &m_TextureID));
+   }
+}
+
+void Framebuffer::Bind() const {
+   GLCall(glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID));
+   GLCall(glViewport(0, 0, m_Width, m_Height));
+}
+
+void Framebuffer::Unbind() const {
+   GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
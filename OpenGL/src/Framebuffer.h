@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+#include "Utils.h"
+
+// Offscreen render target with a single RGBA8 colour texture
+class Framebuffer {
+private:
+   wrap_t<uint32_t> m_RendererID;
+   wrap_t<uint32_t> m_TextureID;
+   int              m_Width, m_Height;
+
+public:
+   Framebuffer(int width, int height);
+   ~Framebuffer();
+
+   Framebuffer(const Framebuffer&)             = delete;
+   Framebuffer(Framebuffer&& other)            = default;
+   Framebuffer& operator=(const Framebuffer&)  = delete;
+   Framebuffer& operator=(Framebuffer&& other) = default;
+
+   // Binds the framebuffer and sets the viewport to cover it
+   void Bind() const;
+   void Unbind() const;
+
+   inline uint32_t GetTextureID() const { return m_TextureID; }
+   inline int      GetWidth() const { return m_Width; }
+   inline int      GetHeight() const { return m_Height; }
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include <utility> // for std::swap
+#include <algorithm>
+#include <type_traits>
 #include "WeakMemoizeConstructor.hpp"
 
 #include <GL/glew.h>
@@ -10,6 +12,8 @@ class IndexBuffer {
 private:
    wrap_t<uint32_t> m_RendererID;
    wrap_t<uint32_t> m_Count;
+   size_t           m_Size  = 0;
+   uint32_t         m_Usage = GL_STATIC_DRAW;
 
 public:
    template <typename Container>
@@ -17,9 +21,34 @@ public:
       static_assert(std::is_same_v<typename Container::value_type, uint32_t>,
                     "Container must contain uint32_t elements");
       m_Count = data.size();
+      m_Size  = m_Count * sizeof(uint32_t);
       GLCall(glGenBuffers(1, &m_RendererID));
       GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Count * sizeof(uint32_t), data.data(), GL_STATIC_DRAW));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, data.data(), GL_STATIC_DRAW));
+   }
+
+   // Empty buffer with room for `count` indices, meant to be refilled with SetData every frame
+   IndexBuffer(size_t count, uint32_t usage)
+      : m_Count(0)
+      , m_Size(count * sizeof(uint32_t))
+      , m_Usage(usage) {
+      GLCall(glGenBuffers(1, &m_RendererID));
+      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+   }
+
+   // Replaces the indices, growing the buffer if needed. Like the constructor this binds through GL_ARRAY_BUFFER so
+   // the element binding of whatever vertex array is bound stays untouched. The old storage is orphaned first.
+   template <typename Container>
+   void SetData(const Container& data) {
+      static_assert(std::is_same_v<typename Container::value_type, uint32_t>,
+                    "Container must contain uint32_t elements");
+      m_Count     = data.size();
+      size_t size = m_Count * sizeof(uint32_t);
+      m_Size      = std::max(m_Size, size);
+      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+      GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data.data()));
    }
 
    IndexBuffer(const IndexBuffer&)             = delete;
@@ -1,9 +1,12 @@
 #include "Input.h"
+#include <array>
+#include <cmath>
 #include "glm/glm.hpp"
 
 float Input::startTime                              = 0;
 float Input::deltaTime                              = 0.01;
 float Input::currentTime                            = 0;
+glm::vec2 Input::mouseWorldPosition                 = {0.0f, 0.0f};
 
 bool  Input::keys_pressed[GLFW_KEY_LAST]            = {false};
 bool  Input::keys_pressed_last_frame[GLFW_KEY_LAST] = {false};
@@ -13,24 +16,48 @@ bool  Input::left_mouse_pressed_down                     = false;
 bool  Input::right_mouse_pressed                          = false;
 bool  Input::right_mouse_pressed_down                     = false;
 
+namespace {
+// The simulation runs at a fixed step and every caller passes a constant time constant, so there are only a handful of
+// distinct factors; remember them instead of calling std::exp for every object on every step
+struct ZenoFactor {
+   float deltaTime    = -1.0f;
+   float timeConstant = 0.0f;
+   float alpha        = 0.0f;
+};
+std::array<ZenoFactor, 8> zenoFactors;
+size_t                    nextZenoFactor = 0;
+
+float zenoAlpha(float timeConstant) {
+   for (auto& factor : zenoFactors) {
+      if (factor.deltaTime == Input::deltaTime && factor.timeConstant == timeConstant) {
+         return factor.alpha;
+      }
+   }
+   auto& factor        = zenoFactors[nextZenoFactor];
+   nextZenoFactor      = (nextZenoFactor + 1) % zenoFactors.size();
+   factor.deltaTime    = Input::deltaTime;
+   factor.timeConstant = timeConstant;
+   factor.alpha        = 1.0f - std::exp(-Input::deltaTime / timeConstant);
+   return factor.alpha;
+}
+} // namespace
+
 float zeno(float current, float target, float timeConstant) {
-   float alpha = 1.0f - std::exp(-Input::deltaTime / timeConstant);
+   float alpha = zenoAlpha(timeConstant);
    return current + alpha * (target - current);
 }
 
 glm::vec2 zeno(const glm::vec2& current, const glm::vec2& target, float timeConstant) {
-   float alpha = 1.0f - std::exp(-Input::deltaTime / timeConstant);
+   float alpha = zenoAlpha(timeConstant);
    return current + alpha * (target - current);
 }
 
 glm::vec3 zeno(const glm::vec3& current, const glm::vec3& target, float timeConstant) {
-   float alpha = 1.0f - std::exp(-Input::deltaTime / timeConstant);
+   float alpha = zenoAlpha(timeConstant);
    return current + alpha * (target - current);
 }
 
 glm::vec4 zeno(const glm::vec4& current, const glm::vec4& target, float timeConstant) {
-   float alpha = 1.0f - std::exp(-Input::deltaTime / timeConstant);
+   float alpha = zenoAlpha(timeConstant);
    return current + alpha * (target - current);
 }
-
-
@@ -14,6 +14,8 @@ public:
    static float startTime;
    static float deltaTime;
    static float currentTime;
+   // World position under the mouse cursor, read once per frame with the keys
+   static glm::vec2 mouseWorldPosition;
 
 private:
    static bool keys_pressed_last_frame[GLFW_KEY_LAST];
@@ -34,6 +36,14 @@ public:
       right_mouse_pressed_down = !right_mouse_pressed && glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_2) == GLFW_PRESS;
       right_mouse_pressed      = glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_2) == GLFW_PRESS;
    }
+
+   // Key states are read once per frame but a frame can run several simulation steps; only the first of them sees
+   // the presses that started this frame
+   static void clearPressedDown() {
+      std::fill(std::begin(keys_pressed_down), std::end(keys_pressed_down), false);
+      left_mouse_pressed_down  = false;
+      right_mouse_pressed_down = false;
+   }
 };
 
 float     zeno(float current, float target, float timeConstant);
@@ -0,0 +1,128 @@
+#include "InputRecording.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+#include "Input.h"
+
+namespace {
+
+// Every key the game reads. Append only: the position of a key is its bit in recordings.
+const std::array<int, 12> RECORDED_KEYS = {
+   GLFW_KEY_W,          GLFW_KEY_A,     GLFW_KEY_S,          GLFW_KEY_D,
+   GLFW_KEY_UP,         GLFW_KEY_LEFT,  GLFW_KEY_DOWN,       GLFW_KEY_RIGHT,
+   GLFW_KEY_SPACE,      GLFW_KEY_O,     GLFW_KEY_LEFT_SHIFT, GLFW_KEY_RIGHT_SHIFT,
+};
+
+const int      KEY_DOWN_SHIFT   = 12;
+const uint32_t LEFT_MOUSE       = 1u << 24;
+const uint32_t LEFT_MOUSE_DOWN  = 1u << 25;
+const uint32_t RIGHT_MOUSE      = 1u << 26;
+const uint32_t RIGHT_MOUSE_DOWN = 1u << 27;
+
+template <typename T>
+bool read(std::ifstream& file, T& value) {
+   return (bool)file.read((char*)&value, sizeof(T));
+}
+
+} // namespace
+
+InputRecorder::InputRecorder(const std::string& path, const std::string& map, uint32_t seed)
+   : file(path, std::ios::binary | std::ios::trunc) {
+   if (!file.is_open()) {
+      std::cerr << "Error opening recording: " << path << std::endl;
+      return;
+   }
+   RecordingHeader header;
+   header.seed          = seed;
+   header.mapPathLength = (uint32_t)map.size();
+   file.write((const char*)&header, sizeof(header));
+   file.write(map.data(), map.size());
+}
+
+void InputRecorder::RecordStep() {
+   if (!file.is_open()) {
+      return;
+   }
+   RecordedStep step;
+   for (size_t i = 0; i < RECORDED_KEYS.size(); i++) {
+      step.bits |= (uint32_t)Input::keys_pressed[RECORDED_KEYS[i]] << i;
+      step.bits |= (uint32_t)Input::keys_pressed_down[RECORDED_KEYS[i]] << (KEY_DOWN_SHIFT + i);
+   }
+   step.bits |= Input::left_mouse_pressed ? LEFT_MOUSE : 0;
+   step.bits |= Input::left_mouse_pressed_down ? LEFT_MOUSE_DOWN : 0;
+   step.bits |= Input::right_mouse_pressed ? RIGHT_MOUSE : 0;
+   step.bits |= Input::right_mouse_pressed_down ? RIGHT_MOUSE_DOWN : 0;
+
+   file.write((const char*)&step.bits, sizeof(step.bits));
+   // The mouse only matters while a button is held
+   if (step.bits & RecordedStep::MOUSE_BITS) {
+      file.write((const char*)&Input::mouseWorldPosition, sizeof(glm::vec2));
+   }
+}
+
+void InputRecorder::Finish(uint64_t stateHash) {
+   if (!file.is_open()) {
+      return;
+   }
+   uint32_t end = RecordingHeader::END_OF_STEPS;
+   file.write((const char*)&end, sizeof(end));
+   file.write((const char*)&stateHash, sizeof(stateHash));
+   file.close();
+}
+
+std::optional<Recording> Recording::Load(const std::string& path) {
+   std::ifstream file(path, std::ios::binary);
+   if (!file.is_open()) {
+      std::cerr << "Error opening recording: " << path << std::endl;
+      return std::nullopt;
+   }
+
+   RecordingHeader header;
+   if (!read(file, header) || header.magic != RecordingHeader::MAGIC || header.version != RecordingHeader::VERSION ||
+       header.mapPathLength > RecordingHeader::MAX_MAP_PATH_LENGTH) {
+      std::cerr << path << " is not a recording" << std::endl;
+      return std::nullopt;
+   }
+
+   Recording recording;
+   recording.seed = header.seed;
+   recording.map.resize(header.mapPathLength);
+   if (!file.read(recording.map.data(), header.mapPathLength)) {
+      std::cerr << path << " is truncated" << std::endl;
+      return std::nullopt;
+   }
+
+   // A session that crashed ends without END_OF_STEPS; keep the steps up to there
+   RecordedStep step;
+   while (read(file, step.bits)) {
+      if (step.bits == RecordingHeader::END_OF_STEPS) {
+         uint64_t stateHash;
+         if (read(file, stateHash)) {
+            recording.stateHash = stateHash;
+         }
+         break;
+      }
+      step.mouse = glm::vec2(0.0f);
+      if ((step.bits & RecordedStep::MOUSE_BITS) && !read(file, step.mouse)) {
+         break;
+      }
+      recording.steps.push_back(step);
+   }
+   return recording;
+}
+
+void Recording::Apply(const RecordedStep& step) {
+   std::fill(std::begin(Input::keys_pressed), std::end(Input::keys_pressed), false);
+   std::fill(std::begin(Input::keys_pressed_down), std::end(Input::keys_pressed_down), false);
+   for (size_t i = 0; i < RECORDED_KEYS.size(); i++) {
+      Input::keys_pressed[RECORDED_KEYS[i]]      = step.bits & (1u << i);
+      Input::keys_pressed_down[RECORDED_KEYS[i]] = step.bits & (1u << (KEY_DOWN_SHIFT + i));
+   }
+   Input::left_mouse_pressed       = step.bits & LEFT_MOUSE;
+   Input::left_mouse_pressed_down  = step.bits & LEFT_MOUSE_DOWN;
+   Input::right_mouse_pressed      = step.bits & RIGHT_MOUSE;
+   Input::right_mouse_pressed_down = step.bits & RIGHT_MOUSE_DOWN;
+   Input::mouseWorldPosition       = step.mouse;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "glm/glm.hpp"
+
+// Input recordings (*.sbr): the input of every fixed simulation step of a session plus the seed of World::rng, which
+// is all it takes to play the session back headlessly with SpaceBoomReplay and end in the same world state.
+//
+//    RecordingHeader
+//    char     map[mapPathLength]       the map the session was played on, as passed to World::LoadMap
+//    per step:
+//    uint32_t bits                     RecordedStep::bits
+//    float    mouse[2]                 only when a mouse bit is set
+//    uint32_t END_OF_STEPS
+//    uint64_t stateHash                World::StateHash after the last step; missing if the game didn't exit cleanly
+//
+// All fields are little-endian.
+struct RecordingHeader {
+   static constexpr uint32_t MAGIC               = 0x52524253; // "SBRR"
+   static constexpr uint32_t VERSION             = 1;
+   static constexpr uint32_t END_OF_STEPS        = UINT32_MAX;
+   // Longest map path Load accepts, so a corrupt header can't ask for a huge allocation
+   static constexpr uint32_t MAX_MAP_PATH_LENGTH = 4096;
+
+   uint32_t magic         = MAGIC;
+   uint32_t version       = VERSION;
+   uint32_t seed          = 0;
+   uint32_t mapPathLength = 0;
+};
+
+static_assert(sizeof(RecordingHeader) == 16, "RecordingHeader is part of the file format");
+
+// The input of one simulation step. Only the keys the game reads are kept: bit i is keys_pressed of the i-th key in
+// InputRecording.cpp, bit 12 + i its keys_pressed_down, and bits 24-27 the left and right mouse button states.
+struct RecordedStep {
+   static constexpr uint32_t MOUSE_BITS = 0xFu << 24;
+
+   uint32_t  bits  = 0;
+   glm::vec2 mouse = glm::vec2(0.0f); // Input::mouseWorldPosition
+};
+
+// Writes a recording while the game runs
+class InputRecorder {
+public:
+   InputRecorder(const std::string& path, const std::string& map, uint32_t seed);
+
+   bool IsOpen() const { return file.is_open(); }
+   // Appends the state of Input as the next step
+   void RecordStep();
+   // Ends the recording with the world state it has to end in
+   void Finish(uint64_t stateHash);
+
+private:
+   std::ofstream file;
+};
+
+struct Recording {
+   uint32_t                  seed = 0;
+   std::string               map;
+   std::vector<RecordedStep> steps;
+   std::optional<uint64_t>   stateHash;
+
+   // nullopt if the file can't be read or isn't a recording
+   static std::optional<Recording> Load(const std::string& path);
+   // Puts the input of a recorded step into Input
+   static void Apply(const RecordedStep& step);
+};
@@ -0,0 +1,220 @@
+#include "MapFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+uint64_t alignTo8(uint64_t offset) {
+   return (offset + 7) & ~uint64_t(7);
+}
+
+// Whether [offset, offset + bytes) lies inside the file. Written without offset + bytes, which a corrupt header could
+// make wrap around.
+bool fits(uint64_t offset, uint64_t bytes, uint64_t fileSize) {
+   return offset <= fileSize && bytes <= fileSize - offset;
+}
+
+// Everything the header claims has to lie inside the file before any of it is read
+bool validate(const MapHeader& header, size_t fileSize) {
+   if (header.magic != MapHeader::MAGIC || header.version != MapHeader::VERSION) {
+      return false;
+   }
+   // Neither product can overflow: both factors are 32-bit
+   uint64_t tileBytes  = (uint64_t)header.width * header.height * sizeof(TileKind);
+   uint64_t spawnBytes = (uint64_t)header.spawnCount * sizeof(MapSpawn);
+   return header.tilesOffset >= sizeof(MapHeader) && fits(header.tilesOffset, tileBytes, fileSize) &&
+          header.spawnsOffset % alignof(MapSpawn) == 0 && fits(header.spawnsOffset, spawnBytes, fileSize);
+}
+
+} // namespace
+
+std::unique_ptr<MappedMap> MappedMap::Open(const std::string& path) {
+   std::unique_ptr<MappedMap> map(new MappedMap());
+
+#ifdef _WIN32
+   map->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+   if (map->file == INVALID_HANDLE_VALUE) {
+      map->file = nullptr;
+      return nullptr;
+   }
+   LARGE_INTEGER fileSize;
+   GetFileSizeEx(map->file, &fileSize);
+   map->size = (size_t)fileSize.QuadPart;
+   if (map->size < sizeof(MapHeader)) {
+      return nullptr;
+   }
+   map->mapping = CreateFileMappingA(map->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   if (!map->mapping) {
+      return nullptr;
+   }
+   map->data = (const std::byte*)MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+   int fd = open(path.c_str(), O_RDONLY);
+   if (fd < 0) {
+      return nullptr;
+   }
+   struct stat status;
+   if (fstat(fd, &status) != 0 || (size_t)status.st_size < sizeof(MapHeader)) {
+      close(fd);
+      return nullptr;
+   }
+   map->size = (size_t)status.st_size;
+   void* data = mmap(nullptr, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (data == MAP_FAILED) {
+      return nullptr;
+   }
+   map->data = (const std::byte*)data;
+#endif
+
+   if (!map->data) {
+      return nullptr;
+   }
+   MapHeader header;
+   std::memcpy(&header, map->data, sizeof(header));
+   if (!validate(header, map->size)) {
+      std::cerr << "Not a version " << MapHeader::VERSION << " map: " << path << std::endl;
+      return nullptr;
+   }
+   return map;
+}
+
+MappedMap::~MappedMap() {
+#ifdef _WIN32
+   if (data) {
+      UnmapViewOfFile(data);
+   }
+   if (mapping) {
+      CloseHandle(mapping);
+   }
+   if (file) {
+      CloseHandle(file);
+   }
+#else
+   if (data) {
+      munmap((void*)data, size);
+   }
+#endif
+}
+
+MapView MappedMap::view() const {
+   MapView view;
+   std::memcpy(&view.header, data, sizeof(view.header));
+   view.tiles  = {(const TileKind*)(data + view.header.tilesOffset), (size_t)view.header.width * view.header.height};
+   view.spawns = {(const MapSpawn*)(data + view.header.spawnsOffset), view.header.spawnCount};
+   return view;
+}
+
+MapData MapFile::ParseText(std::istream& in) {
+   std::vector<std::string> lines;
+   std::string              line;
+   while (std::getline(in, line)) {
+      lines.push_back(std::move(line));
+   }
+
+   MapData map;
+   map.header.height  = (uint32_t)lines.size();
+   map.header.originY = 1; // the last line is y = 1
+   for (const auto& text : lines) {
+      map.header.width = std::max(map.header.width, (uint32_t)text.size());
+   }
+   map.tiles.assign((size_t)map.header.width * map.header.height, TileKind::Empty);
+
+   for (size_t i = 0; i < lines.size(); ++i) {
+      uint32_t row = map.header.height - 1 - (uint32_t)i;
+      for (uint32_t x = 0; x < lines[i].size(); ++x) {
+         auto&   tile = map.tiles[(size_t)row * map.header.width + x];
+         int32_t y    = map.header.originY + (int32_t)row;
+         switch (lines[i][x]) {
+         case 'b': map.spawns.push_back({SpawnKind::Background, {}, (int32_t)x, y}); break;
+         case 'f': tile = TileKind::Floor; break;
+         case 'w': tile = TileKind::Wall; break;
+         case 'W': tile = TileKind::UnbreakableWall; break;
+         case 'p':
+            map.spawns.push_back({SpawnKind::Player, {}, (int32_t)x, y});
+            tile = TileKind::Floor;
+            break;
+         case 'e':
+            map.spawns.push_back({SpawnKind::Bomber, {}, (int32_t)x, y});
+            tile = TileKind::Floor;
+            break;
+         case 't':
+            map.spawns.push_back({SpawnKind::Turret, {}, (int32_t)x, y});
+            tile = TileKind::Floor;
+            break;
+         case 'm':
+            map.spawns.push_back({SpawnKind::Mine, {}, (int32_t)x, y});
+            tile = TileKind::Floor;
+            break;
+         default: break;
+         }
+      }
+   }
+
+   map.header.spawnCount   = (uint32_t)map.spawns.size();
+   map.header.tilesOffset  = sizeof(MapHeader);
+   map.header.spawnsOffset = alignTo8(map.header.tilesOffset + map.tiles.size() * sizeof(TileKind));
+   return map;
+}
+
+void MapFile::WriteText(const MapView& map, std::ostream& out) {
+   const char tileChars[] = {' ', 'f', 'w', 'W'};
+
+   std::vector<std::string> lines(map.header.height);
+   for (uint32_t row = 0; row < map.header.height; ++row) {
+      auto& line = lines[map.header.height - 1 - row];
+      line.resize(map.header.width);
+      for (uint32_t column = 0; column < map.header.width; ++column) {
+         line[column] = tileChars[(size_t)map.at(column, row)];
+      }
+   }
+
+   const char spawnChars[] = {'b', 'p', 'e', 't', 'm'};
+   for (const auto& spawn : map.spawns) {
+      int32_t column = spawn.x - map.header.originX;
+      int32_t row    = spawn.y - map.header.originY;
+      if (column >= 0 && row >= 0 && (uint32_t)column < map.header.width && (uint32_t)row < map.header.height) {
+         lines[map.header.height - 1 - row][column] = spawnChars[(size_t)spawn.kind];
+      }
+   }
+
+   for (auto& line : lines) {
+      line.erase(line.find_last_not_of(' ') + 1);
+      out << line << '\n';
+   }
+}
+
+bool MapFile::Write(const MapView& map, const std::string& path) {
+   MapHeader header    = map.header;
+   header.magic        = MapHeader::MAGIC;
+   header.version      = MapHeader::VERSION;
+   header.spawnCount   = (uint32_t)map.spawns.size();
+   header.tilesOffset  = sizeof(MapHeader);
+   header.spawnsOffset = alignTo8(header.tilesOffset + map.tiles.size_bytes());
+
+   std::ofstream file(path, std::ios::binary | std::ios::trunc);
+   if (!file.is_open()) {
+      return false;
+   }
+   const char padding[8] = {};
+   file.write((const char*)&header, sizeof(header));
+   file.write((const char*)map.tiles.data(), map.tiles.size_bytes());
+   file.write(padding, header.spawnsOffset - (header.tilesOffset + map.tiles.size_bytes()));
+   file.write((const char*)map.spawns.data(), map.spawns.size_bytes());
+   return file.good();
+}
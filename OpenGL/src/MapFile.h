@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+// Binary map format (*.sbm). Laid out so a memory-mapped file can be used in place:
+//
+//    MapHeader
+//    TileKind tiles[width * height]   row-major, row 0 at the bottom; padded to 8 bytes
+//    MapSpawn spawns[spawnCount]      in the order the objects are created
+//
+// All fields are little-endian. Tile (i % width, i / width) is at world position (originX + i % width,
+// originY + i / width). Convert the ASCII maps with SpaceBoomMapConvert.
+enum class TileKind : uint8_t {
+   Empty,
+   Floor,
+   Wall,
+   UnbreakableWall,
+};
+
+enum class SpawnKind : uint8_t {
+   Background,
+   Player,
+   Bomber,
+   Turret,
+   Mine,
+};
+
+struct MapHeader {
+   static constexpr uint32_t MAGIC   = 0x504d4253; // "SBMP"
+   static constexpr uint32_t VERSION = 1;
+
+   uint32_t magic        = MAGIC;
+   uint32_t version      = VERSION;
+   uint32_t width        = 0;
+   uint32_t height       = 0;
+   int32_t  originX      = 0;
+   int32_t  originY      = 0;
+   uint32_t spawnCount   = 0;
+   uint32_t reserved     = 0;
+   uint64_t tilesOffset  = 0; // bytes from the start of the file
+   uint64_t spawnsOffset = 0;
+};
+
+struct MapSpawn {
+   SpawnKind kind;
+   uint8_t   reserved[3];
+   int32_t   x;
+   int32_t   y;
+};
+
+static_assert(sizeof(MapHeader) == 48, "MapHeader is part of the file format");
+static_assert(sizeof(MapSpawn) == 12, "MapSpawn is part of the file format");
+
+// A map in memory, either parsed from text or pointing into a mapped .sbm file
+struct MapView {
+   MapHeader                 header;
+   std::span<const TileKind> tiles;
+   std::span<const MapSpawn> spawns;
+
+   TileKind at(uint32_t column, uint32_t row) const { return tiles[(size_t)row * header.width + column]; }
+};
+
+// Owns the arrays of a map parsed from the ASCII format
+struct MapData {
+   MapHeader             header;
+   std::vector<TileKind> tiles;
+   std::vector<MapSpawn> spawns;
+
+   MapView view() const { return {header, tiles, spawns}; }
+};
+
+// A read-only memory mapping of an .sbm file. The view stays valid as long as the MappedMap does.
+class MappedMap {
+public:
+   // Maps and validates the file; nullptr if it can't be opened or isn't a map of this version
+   static std::unique_ptr<MappedMap> Open(const std::string& path);
+   ~MappedMap();
+
+   MappedMap(const MappedMap&)            = delete;
+   MappedMap& operator=(const MappedMap&) = delete;
+
+   MapView view() const;
+
+private:
+   MappedMap() = default;
+
+   const std::byte* data = nullptr;
+   size_t           size = 0;
+#ifdef _WIN32
+   void* file    = nullptr;
+   void* mapping = nullptr;
+#endif
+};
+
+namespace MapFile {
+// Parses the ASCII format ('w' wall, 'W' unbreakable wall, 'f' floor, 'p' player, 'e' bomber, 't' turret, 'm' mine,
+// 'b' background). Spawns other than the background stand on a floor tile. The last line is row 1.
+MapData ParseText(std::istream& in);
+// The inverse of ParseText. A spawn replaces the character of the tile it stands on, so only the background may be
+// placed on an empty tile and everything else needs a floor. Trailing empty tiles of a line are left out.
+void    WriteText(const MapView& map, std::ostream& out);
+bool    Write(const MapView& map, const std::string& path);
+} // namespace MapFile
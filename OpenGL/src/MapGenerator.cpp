@@ -0,0 +1,122 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Uniform integer in [min, max], without std::uniform_int_distribution, whose output differs between standard
+// libraries
+uint32_t randomRange(std::mt19937& rng, uint32_t min, uint32_t max) {
+   return min + rng() % (max - min + 1);
+}
+
+// true with the given probability, in steps of 1 / 2^24
+bool chance(std::mt19937& rng, float probability) {
+   return (rng() >> 8) < (uint32_t)(probability * (1u << 24));
+}
+
+} // namespace
+
+MapData MapGenerator::Generate(const MapGeneratorOptions& options) {
+   std::mt19937 rng(options.seed);
+   uint32_t     width  = std::max(options.width, 8u);
+   uint32_t     height = std::max(options.height, 8u);
+
+   MapData map;
+   map.header.width  = width;
+   map.header.height = height;
+   map.tiles.assign((size_t)width * height, TileKind::Floor);
+   auto tile = [&](uint32_t x, uint32_t y) -> TileKind& { return map.tiles[(size_t)y * width + x]; };
+
+   for (uint32_t x = 0; x < width; x++) {
+      tile(x, 0) = tile(x, height - 1) = TileKind::UnbreakableWall;
+   }
+   for (uint32_t y = 0; y < height; y++) {
+      tile(0, y) = tile(width - 1, y) = TileKind::UnbreakableWall;
+   }
+
+   // Split into rows and columns of rooms; each dividing wall gets doorways below
+   for (uint32_t y = randomRange(rng, 6, 14); y < height - 1; y += randomRange(rng, 6, 14)) {
+      for (uint32_t x = 1; x < width - 1; x++) {
+         tile(x, y) = TileKind::Wall;
+      }
+   }
+   for (uint32_t x = randomRange(rng, 6, 14); x < width - 1; x += randomRange(rng, 6, 14)) {
+      for (uint32_t y = 1; y < height - 1; y++) {
+         tile(x, y) = TileKind::Wall;
+      }
+   }
+   auto isWall = [&](uint32_t x, uint32_t y) { return tile(x, y) != TileKind::Floor; };
+   for (uint32_t y = 1; y < height - 1; y++) {
+      for (uint32_t x = 1; x < width - 1; x++) {
+         bool horizontalWall = isWall(x, y) && isWall(x - 1, y) && isWall(x + 1, y);
+         bool verticalWall   = isWall(x, y) && isWall(x, y - 1) && isWall(x, y + 1);
+         if ((horizontalWall != verticalWall) && chance(rng, 0.12f)) {
+            tile(x, y) = TileKind::Floor;
+         } else if (tile(x, y) == TileKind::Floor && chance(rng, 0.04f)) {
+            tile(x, y) = TileKind::Wall;
+         }
+      }
+   }
+
+   // The background is drawn everywhere; it just needs an empty tile to stand on in the text format
+   if (options.background) {
+      tile(0, height - 1) = TileKind::Empty;
+      map.spawns.push_back({SpawnKind::Background, {}, 0, (int32_t)height - 1});
+   }
+
+   // Player on the floor tile closest to the centre
+   int32_t playerX = (int32_t)width / 2;
+   int32_t playerY = (int32_t)height / 2;
+   for (int32_t radius = 0; radius < (int32_t)std::max(width, height); radius++) {
+      bool found = false;
+      for (int32_t dy = -radius; dy <= radius && !found; dy++) {
+         for (int32_t dx = -radius; dx <= radius && !found; dx++) {
+            int32_t x = (int32_t)width / 2 + dx;
+            int32_t y = (int32_t)height / 2 + dy;
+            if (x > 0 && y > 0 && x < (int32_t)width - 1 && y < (int32_t)height - 1 && tile(x, y) == TileKind::Floor) {
+               playerX = x;
+               playerY = y;
+               found   = true;
+            }
+         }
+      }
+      if (found) {
+         break;
+      }
+   }
+   map.spawns.push_back({SpawnKind::Player, {}, playerX, playerY});
+
+   for (uint32_t y = 1; y < height - 1; y++) {
+      for (uint32_t x = 1; x < width - 1; x++) {
+         if (tile(x, y) != TileKind::Floor ||
+             std::abs((int32_t)x - playerX) + std::abs((int32_t)y - playerY) < options.safeRadius) {
+            continue;
+         }
+         // at most one spawn per tile, so a single draw picks which (if any)
+         float roll = (float)(rng() >> 8) / (1u << 24);
+         if (roll < options.bomberDensity) {
+            map.spawns.push_back({SpawnKind::Bomber, {}, (int32_t)x, (int32_t)y});
+         } else if (roll < options.bomberDensity + options.turretDensity) {
+            map.spawns.push_back({SpawnKind::Turret, {}, (int32_t)x, (int32_t)y});
+         } else if (roll < options.bomberDensity + options.turretDensity + options.mineDensity) {
+            map.spawns.push_back({SpawnKind::Mine, {}, (int32_t)x, (int32_t)y});
+         }
+      }
+   }
+
+   // Same origin and spawn order as MapFile::ParseText gives the map written as text (last line at y = 1, spawns in
+   // reading order), so a seed loads identically from .txt and .sbm
+   map.header.originY = 1;
+   for (auto& spawn : map.spawns) {
+      spawn.y += map.header.originY;
+   }
+   std::sort(map.spawns.begin(), map.spawns.end(), [](const MapSpawn& a, const MapSpawn& b) {
+      return a.y != b.y ? a.y > b.y : a.x < b.x;
+   });
+
+   map.header.spawnCount = (uint32_t)map.spawns.size();
+   return map;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "MapFile.h"
+
+struct MapGeneratorOptions {
+   uint32_t width  = 128;
+   uint32_t height = 128;
+   uint32_t seed   = 1;
+   // Expected number of each enemy per floor tile
+   float bomberDensity = 0.002f;
+   float turretDensity = 0.001f;
+   float mineDensity   = 0.002f;
+   // Enemies are kept at least this many tiles (manhattan) away from the player's start
+   int  safeRadius = 6;
+   bool background = true;
+};
+
+// Seeded space-station layouts for stress tests: rooms of random size separated by walls with doorways, scattered
+// pillars, an unbreakable outer hull, the player near the centre and enemies spread over the floor. The same options
+// always give the same map, on every platform (std::mt19937 plus integer arithmetic only).
+namespace MapGenerator {
+MapData Generate(const MapGeneratorOptions& options);
+}
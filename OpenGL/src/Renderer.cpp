@@ -1,20 +1,29 @@
 #include "Renderer.h"
 #include "VertexBufferLayout.h"
 #include "game_objects/Camera.h"
+#include "Input.h"
+#include "AssetLoader.h"
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 std::string Renderer::res_path;
 
-ImFont* load_font(ImGuiIO* io, const std::string& font_name, int size) {
-   auto    f    = Renderer::ResPath() + font_name;
-   ImFont* font = io->Fonts->AddFontFromFileTTF(f.c_str(), size);
-   return font;
+ImFont* load_font(ImGuiIO* io, const std::shared_future<std::shared_ptr<const std::vector<char>>>& file, int size) {
+   auto& bytes = *file.get();
+   if (bytes.empty()) {
+      return nullptr;
+   }
+   // the atlas takes ownership of the data and frees it with IM_FREE
+   void* data = IM_ALLOC(bytes.size());
+   std::memcpy(data, bytes.data(), bytes.size());
+   return io->Fonts->AddFontFromMemoryTTF(data, (int)bytes.size(), (float)size);
 }
 
-glm::mat4 CalculateMVP(std::tuple<int, int> windowSize, const glm::vec2& objectPosition, float objectRotationDegrees,
-                       float objectScale) {
+glm::mat4 CalculateMVP(std::tuple<int, int> windowSize, const glm::vec2& cameraPosition,
+                       const glm::vec2& objectPosition, float objectRotationDegrees, float objectScale) {
    // Retrieve window size from the renderer
    auto [width, height] = windowSize;
 
@@ -27,46 +36,31 @@ glm::mat4 CalculateMVP(std::tuple<int, int> windowSize, const glm::vec2& objectP
       glm::ortho(-orthoWidth / 2.0f, orthoWidth / 2.0f, -Camera::scale / 2.0f, Camera::scale / 2.0f, -1.0f, 1.0f);
 
    // Create view matrix
-   glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(-Camera::position, 0.0f));
+   glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(-cameraPosition, 0.0f));
+
+   // Combine matrices to form MVP
+   glm::mat4 mvp = projection * view * ModelMatrix(objectPosition, objectRotationDegrees, objectScale);
+
+   return mvp;
+}
 
-   // Create model matrix
+glm::mat4 ModelMatrix(const glm::vec2& objectPosition, float objectRotationDegrees, float objectScale) {
    glm::mat4 model           = glm::translate(glm::mat4(1.0f), glm::vec3(objectPosition, 0.0f));
    float     rotationRadians = glm::radians(objectRotationDegrees);
    model                     = glm::rotate(model, rotationRadians, glm::vec3(0.0f, 0.0f, 1.0f));
    model                     = glm::scale(model, glm::vec3(objectScale, objectScale, 1.0f));
-
-   // Combine matrices to form MVP
-   glm::mat4 mvp = projection * view * model;
-
-   return mvp;
+   return model;
 }
 
 glm::vec2 Renderer::ScreenToWorldPosition(const glm::vec2& screenPos) {
-   // Retrieve window size from the renderer
-   auto [width, height] = WindowSize();
-
-   // Calculate aspect ratio
-   float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
-
-   // Calculate orthographic projection matrix
-   float     orthoWidth = Camera::scale * aspectRatio;
-   glm::mat4 projection =
-      glm::ortho(-orthoWidth / 2.0f, orthoWidth / 2.0f, -Camera::scale / 2.0f, Camera::scale / 2.0f, -1.0f, 1.0f);
-
-   // Create view matrix
-   glm::mat4 view = glm::translate(glm::mat4(1.0f), glm::vec3(-Camera::position, 0.0f));
-
-   // Inverse of MVP
-   glm::mat4 invVP = glm::inverse(projection * view);
-
    // Normalize screen coordinates (convert to [-1, 1] range)
    glm::vec2 normalizedScreenPos;
-   normalizedScreenPos.x = (2.0f * screenPos.x) / width - 1.0f;
-   normalizedScreenPos.y = 1.0f - (2.0f * screenPos.y) / height;
+   normalizedScreenPos.x = (2.0f * screenPos.x) / camera.width - 1.0f;
+   normalizedScreenPos.y = 1.0f - (2.0f * screenPos.y) / camera.height;
 
    // Convert to world space by applying the inverse matrix
    glm::vec4 clipSpacePos  = glm::vec4(normalizedScreenPos, 0.0f, 1.0f);
-   glm::vec4 worldSpacePos = invVP * clipSpacePos;
+   glm::vec4 worldSpacePos = camera.inverseViewProjection * clipSpacePos;
 
    // Return world position with z=0
    return glm::vec2(worldSpacePos.x, worldSpacePos.y);
@@ -109,12 +103,25 @@ Renderer::Renderer(GLFWwindow* window, ImGuiIO* io)
    lineVa = std::make_shared<VertexArray>(lineVb, layout);
    lineIb = IndexBuffer::create(indices);
 
-   Renderer::jacquard12_big   = load_font(io, "fonts/Jacquard12.ttf", 40);
-   Renderer::jacquard12_small = load_font(io, "fonts/Jacquard12.ttf", 18);
-   Renderer::Pixelify         = load_font(io, "fonts/PixelifySans.ttf", 18);
+   // FrameData uniform block shared by every shader that includes includes/frame.shader
+   GLCall(glGenBuffers(1, &frameUbo));
+   GLCall(glBindBuffer(GL_UNIFORM_BUFFER, frameUbo));
+   GLCall(glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW));
+   GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, Shader::FRAME_BLOCK_BINDING, frameUbo));
+
+   // Both font files are read in parallel
+   auto jacquard12            = AssetLoader::ReadFile(ResPath() + "fonts/Jacquard12.ttf");
+   auto pixelify              = AssetLoader::ReadFile(ResPath() + "fonts/PixelifySans.ttf");
+   Renderer::jacquard12_big   = load_font(io, jacquard12, 40);
+   Renderer::jacquard12_small = load_font(io, jacquard12, 18);
+   Renderer::Pixelify         = load_font(io, pixelify, 18);
 }
 
-Renderer::~Renderer() {}
+Renderer::~Renderer() {
+   if (frameUbo != 0) {
+      GLCall(glDeleteBuffers(1, &frameUbo));
+   }
+}
 
 void Renderer::Clear() const {
    GLCall(glClear(GL_COLOR_BUFFER_BIT));
@@ -127,6 +134,42 @@ void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader&
    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
 }
 
+void Renderer::BeginFrame(glm::vec2 playerPosition, float interpolation) {
+   auto [width, height] = WindowSize();
+   // a minimised window reports 0x0; keep the matrices finite
+   camera.width  = std::max(width, 1);
+   camera.height = std::max(height, 1);
+   GLCall(glViewport(0, 0, (GLsizei)camera.width, (GLsizei)camera.height));
+
+   camera.interpolation = interpolation;
+   glm::vec2 center     = glm::mix(Camera::previousPosition, Camera::position, interpolation);
+
+   camera.viewProjection        = CalculateMVP({camera.width, camera.height}, center, {0, 0}, 0, 1);
+   camera.inverseViewProjection = glm::inverse(camera.viewProjection);
+
+   float     aspectRatio = static_cast<float>(camera.width) / static_cast<float>(camera.height);
+   glm::vec2 halfExtent  = glm::vec2(Camera::scale * aspectRatio, Camera::scale) / 2.0f;
+   camera.viewMin        = center - halfExtent;
+   camera.viewMax        = center + halfExtent;
+
+   // One upload per frame; every shader reads it through the block binding
+   FrameUniforms uniforms;
+   uniforms.viewProjection        = camera.viewProjection;
+   uniforms.inverseViewProjection = camera.inverseViewProjection;
+   uniforms.resolution            = {(float)camera.width, (float)camera.height};
+   uniforms.playerPosition        = playerPosition;
+   uniforms.time                  = (float)glfwGetTime();
+   uniforms.startTime             = Input::startTime;
+   uniforms.padding               = {0.0f, 0.0f};
+   GLCall(glBindBuffer(GL_UNIFORM_BUFFER, frameUbo));
+   GLCall(glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &uniforms));
+}
+
+void Renderer::FlushBatches() {
+   tiles.Flush(camera.viewProjection);
+   sprites.Flush();
+}
+
 void Renderer::DrawLine(glm::vec2 start, glm::vec2 end, glm::vec4 color) {
    lineShader.Bind();
    lineShader.SetUniform4f("u_Color", color);
@@ -134,10 +177,6 @@ void Renderer::DrawLine(glm::vec2 start, glm::vec2 end, glm::vec4 color) {
    lineShader.SetUniform2f("u_EndPos", end);
    lineShader.SetUniform1f("u_Width", 0.1f);
 
-   auto mvp = CalculateMVP(WindowSize(), {0, 0}, 0, 1);
-   // Pass MVP matrix to the shader
-   lineShader.SetUniformMat4f("u_MVP", mvp);
-
    // create a vertex buffer and index buffer
    Draw(*lineVa, *lineIb, lineShader);
 }
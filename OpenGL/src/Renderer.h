@@ -14,6 +14,8 @@
 #include "Utils.h"
 #include "AudioEngine.h"
 #include "Shader.h"
+#include "SpriteBatch.h"
+#include "TileLayer.h"
 
 #include "imgui.h"
 
@@ -23,6 +25,18 @@ public:
    glm::vec2 end;
    glm::vec4 color;
 };
+// Camera state of the current frame, computed once by Renderer::BeginFrame
+struct CameraState {
+   glm::mat4 viewProjection        = glm::mat4(1.0f);
+   glm::mat4 inverseViewProjection = glm::mat4(1.0f);
+   int       width                 = 1; // framebuffer size in pixels
+   int       height                = 1;
+   glm::vec2 viewMin               = glm::vec2(0.0f); // world-space rectangle on screen
+   glm::vec2 viewMax               = glm::vec2(0.0f);
+   // How far between the previous simulation step and the latest one this frame is drawn, see FixedClock
+   float     interpolation         = 1.0f;
+};
+
 class Renderer {
 public:
    Renderer(GLFWwindow* window, ImGuiIO* io);
@@ -36,10 +50,17 @@ public:
    glm::vec2 MousePos();
 
 
+   // Captures the camera and window size for the frame, sets the viewport and fills the FrameData uniform block.
+   // Call once per frame after the camera and player have moved and before anything is drawn.
+   void                 BeginFrame(glm::vec2 playerPosition, float interpolation);
    void                 Clear() const;
    void                 Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+   // Draws every tile and sprite submitted since the last flush, tiles first. Called at the end of each draw layer.
+   void                 FlushBatches();
    void                 DrawDebug();
    std::tuple<int, int> WindowSize() const;
+   // World-space rectangle (min, max corner) the camera shows this frame
+   std::pair<glm::vec2, glm::vec2> ViewBounds() const { return {camera.viewMin, camera.viewMax}; }
 
    static const std::string& ResPath();
    static void               DebugLine(glm::vec2 start, glm::vec2 end, glm::vec3 color);
@@ -48,6 +69,8 @@ public:
    // Window pointer
    GLFWwindow* window;
 
+   CameraState camera;
+
    // IMGUI IO
    ImGuiIO* io;
 
@@ -57,16 +80,36 @@ public:
    std::shared_ptr<IndexBuffer>  lineIb;
    std::shared_ptr<VertexArray>  lineVa;
 
+   // Batches the sprites of SquareObjects, and the map's tiles as instances
+   SpriteBatch sprites;
+   TileLayer   tiles;
+
    static ImFont* jacquard12_big;
    static ImFont* jacquard12_small;
    static ImFont* Pixelify;
 
 
 private:
+   // std140 layout of the FrameData block in res/shaders/includes/frame.shader
+   struct FrameUniforms {
+      glm::mat4 viewProjection;
+      glm::mat4 inverseViewProjection;
+      glm::vec2 resolution;
+      glm::vec2 playerPosition;
+      float     time;
+      float     startTime;
+      glm::vec2 padding; // std140 rounds the block up to a multiple of 16 bytes
+   };
+   static_assert(sizeof(FrameUniforms) == 160, "FrameUniforms must match the std140 layout of FrameData");
+
+   wrap_t<uint32_t> frameUbo;
+
    static std::string        res_path;
    void                      DrawLine(glm::vec2 start, glm::vec2 end, glm::vec4 color);
    static std::vector<Line>& GetDebugLines();
 };
 
-glm::mat4 CalculateMVP(std::tuple<int, int> windowSize, const glm::vec2& objectPosition, float objectRotationDegrees,
-                       float objectScale);
+glm::mat4 CalculateMVP(std::tuple<int, int> windowSize, const glm::vec2& cameraPosition,
+                       const glm::vec2& objectPosition, float objectRotationDegrees, float objectScale);
+// The model part of CalculateMVP: translate * rotate * scale
+glm::mat4 ModelMatrix(const glm::vec2& objectPosition, float objectRotationDegrees, float objectScale);
@@ -1,15 +1,112 @@
 #include "Shader.h"
 
+#include <chrono>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <sstream>
 #include <filesystem>
+#include <vector>
 #include "Renderer.h"
 #include <glm/glm.hpp>
+#include "xxhash.h"
 
 namespace fs = std::filesystem;
 
+namespace {
+
+struct SetupStats {
+   int    programs  = 0;
+   int    cacheHits = 0;
+   double seconds   = 0.0;
+};
+
+SetupStats setupStats;
+
+// Program binaries are only valid for the driver that produced them, so the driver is part of the key
+const std::string& DriverSignature() {
+   static const std::string signature = [] {
+      auto str = [](GLenum name) {
+         auto value = glGetString(name);
+         return value ? std::string((const char*)value) : std::string();
+      };
+      return str(GL_VENDOR) + '\n' + str(GL_RENDERER) + '\n' + str(GL_VERSION);
+   }();
+   return signature;
+}
+
+bool ProgramBinariesSupported() {
+   static const bool supported = [] {
+      if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) {
+         return false;
+      }
+      GLint formats = 0;
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+      return formats > 0;
+   }();
+   return supported;
+}
+
+fs::path CachePath(const std::string& vertexShader, const std::string& fragmentShader) {
+   // The sources are already expanded, so an edited include changes the key too
+   std::string key = vertexShader + '\0' + fragmentShader + '\0' + DriverSignature();
+   char        name[32];
+   std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)XXH64(key.data(), key.size(), 0));
+
+   std::error_code error;
+   return fs::temp_directory_path(error) / "SpaceBoom" / "shader_cache" / name;
+}
+
+// Cache file layout: the binary format enum followed by the program binary
+uint32_t LoadCachedProgram(const fs::path& path) {
+   std::ifstream file(path, std::ios::binary);
+   if (!file.is_open()) {
+      return 0;
+   }
+   GLenum format = 0;
+   if (!file.read((char*)&format, sizeof(format))) {
+      return 0;
+   }
+   std::vector<char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+   if (binary.empty()) {
+      return 0;
+   }
+
+   uint32_t program = glCreateProgram();
+   glProgramBinary(program, format, binary.data(), (GLsizei)binary.size());
+   int linked = GL_FALSE;
+   glGetProgramiv(program, GL_LINK_STATUS, &linked);
+   if (linked == GL_FALSE) {
+      // e.g. a driver update that kept the version string; recompile and overwrite the entry
+      glDeleteProgram(program);
+      return 0;
+   }
+   return program;
+}
+
+void StoreCachedProgram(const fs::path& path, uint32_t program) {
+   GLint length = 0;
+   glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+   if (length <= 0) {
+      return;
+   }
+   std::vector<char> binary(length);
+   GLenum            format = 0;
+   glGetProgramBinary(program, length, &length, &format, binary.data());
+
+   std::error_code error;
+   fs::create_directories(path.parent_path(), error);
+   std::ofstream file(path, std::ios::binary | std::ios::trunc);
+   if (!file.is_open()) {
+      return;
+   }
+   file.write((const char*)&format, sizeof(format));
+   file.write(binary.data(), length);
+}
+
+} // namespace
+
 Shader::Shader(const std::string& filepath)
    : m_FilePath(filepath)
    , m_RendererID(0) {
@@ -17,6 +114,7 @@ Shader::Shader(const std::string& filepath)
    ShaderProgramSource source = ParseShader(filepath);
    m_RendererID               = CreateShader(source.VertexSource, source.FragmentSource);
    m_last_write               = fs::last_write_time(fs::path{m_FilePath});
+   ResolveProgramInterface();
 }
 
 Shader::~Shader() {
@@ -119,12 +217,39 @@ uint32_t Shader::CreateShader(const std::string& vertexShader, const std::string
    if (vertexShader.empty() || fragmentShader.empty())
       return 0;
 
+   auto start = std::chrono::steady_clock::now();
+
+   bool     cacheable = ProgramBinariesSupported();
+   fs::path cachePath = cacheable ? CachePath(vertexShader, fragmentShader) : fs::path();
+   uint32_t program   = cacheable ? LoadCachedProgram(cachePath) : 0;
+   bool     cacheHit  = program != 0;
+   if (!cacheHit) {
+      program = CompileProgram(vertexShader, fragmentShader);
+      if (program && cacheable) {
+         StoreCachedProgram(cachePath, program);
+      }
+   }
+
+   double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+   setupStats.programs++;
+   setupStats.cacheHits += cacheHit;
+   setupStats.seconds   += seconds;
+   std::cout << "  " << (cacheHit ? "loaded from binary cache" : "compiled from source") << " in " << seconds * 1000.0
+             << " ms" << std::endl;
+
+   return program;
+}
+
+uint32_t Shader::CompileProgram(const std::string& vertexShader, const std::string& fragmentShader) {
    uint32_t program = 0;
    uint32_t vs      = CompileShader(GL_VERTEX_SHADER, vertexShader);
    uint32_t fs      = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
 
    if (vs && fs) {
       program = glCreateProgram();
+      if (ProgramBinariesSupported()) {
+         glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+      }
       glAttachShader(program, vs);
       glAttachShader(program, fs);
       glLinkProgram(program);
@@ -132,11 +257,28 @@ uint32_t Shader::CreateShader(const std::string& vertexShader, const std::string
 
       glDeleteShader(vs);
       glDeleteShader(fs);
+
+      int linked = GL_FALSE;
+      glGetProgramiv(program, GL_LINK_STATUS, &linked);
+      if (linked == GL_FALSE) {
+         std::cout << "Failed to link shader program!" << std::endl;
+         glDeleteProgram(program);
+         return 0;
+      }
+   } else {
+      // whichever stage did compile
+      glDeleteShader(vs);
+      glDeleteShader(fs);
    }
 
    return program;
 }
 
+void Shader::LogSetupStats() {
+   std::cout << "Shader setup: " << setupStats.programs << " programs (" << setupStats.cacheHits
+             << " from the binary cache) in " << setupStats.seconds * 1000.0 << " ms" << std::endl;
+}
+
 void Shader::UpdateIfNeeded() {
    fs::path p{m_FilePath};
    auto     last_write = fs::last_write_time(p);
@@ -145,10 +287,24 @@ void Shader::UpdateIfNeeded() {
       if (auto id = CreateShader(source.VertexSource, source.FragmentSource)) {
          m_RendererID = id;
          m_last_write = last_write;
+         m_UniformLocationCache.clear();
+         ResolveProgramInterface();
       }
    }
 }
 
+void Shader::ResolveProgramInterface() {
+   if (m_RendererID == 0) {
+      m_MVPLocation = -1;
+      return;
+   }
+   uint32_t index = glGetUniformBlockIndex(m_RendererID, "FrameData");
+   if (index != GL_INVALID_INDEX) {
+      GLCall(glUniformBlockBinding(m_RendererID, index, FRAME_BLOCK_BINDING));
+   }
+   m_MVPLocation = glGetUniformLocation(m_RendererID, "u_MVP");
+}
+
 void Shader::Bind() const {
    GLCall(glUseProgram(m_RendererID));
 }
@@ -158,36 +314,59 @@ void Shader::Unbind() const {
 }
 
 void Shader::SetUniform1i(const std::string& name, int value) {
-   GLCall(glUniform1i(GetUniformLocation(name), value));
+   SetUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform1f(const std::string& name, float value) {
-   GLCall(glUniform1f(GetUniformLocation(name), value));
+   SetUniform1f(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform2f(const std::string& name, const glm::vec2& value) {
-   GLCall(glUniform2f(GetUniformLocation(name), value.x, value.y));
+   SetUniform2f(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform3f(const std::string& name, const glm::vec3& value) {
-   GLCall(glUniform3f(GetUniformLocation(name), value.x, value.y, value.z));
+   SetUniform3f(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniform4f(const std::string& name, const glm::vec4& value) {
-   GLCall(glUniform4f(GetUniformLocation(name), value.x, value.y, value.z, value.w));
+   SetUniform4f(GetUniformLocation(name), value);
 }
 
 void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix) {
-   GLCall(glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]));
+   SetUniformMat4f(GetUniformLocation(name), matrix);
+}
+
+void Shader::SetUniform1i(int location, int value) {
+   GLCall(glUniform1i(location, value));
+}
+
+void Shader::SetUniform1f(int location, float value) {
+   GLCall(glUniform1f(location, value));
+}
+
+void Shader::SetUniform2f(int location, const glm::vec2& value) {
+   GLCall(glUniform2f(location, value.x, value.y));
+}
+
+void Shader::SetUniform3f(int location, const glm::vec3& value) {
+   GLCall(glUniform3f(location, value.x, value.y, value.z));
+}
+
+void Shader::SetUniform4f(int location, const glm::vec4& value) {
+   GLCall(glUniform4f(location, value.x, value.y, value.z, value.w));
+}
+
+void Shader::SetUniformMat4f(int location, const glm::mat4& matrix) {
+   GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, &matrix[0][0]));
 }
 
-uint32_t Shader::GetUniformLocation(const std::string& name) {
+int Shader::GetUniformLocation(const std::string& name) {
    if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
       return m_UniformLocationCache[name];
 
    GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
-   if (location == -1 && name.find("u_StartTime") == std::string::npos && name.find("u_Color") == std::string::npos &&
-       name.find("u_Time") == std::string::npos && name.find("u_MVP") == std::string::npos) {
+   if (location == -1 && name.find("u_Color") == std::string::npos && name.find("u_MVP") == std::string::npos) {
 
       std::cout << "Warning: uniform '" << name << "' doesn't exist for shader at " << m_FilePath << "!" << std::endl;
    }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <filesystem>
@@ -18,8 +19,12 @@ private:
    std::filesystem::file_time_type      m_last_write;
    wrap_t<uint32_t>                     m_RendererID;
    std::unordered_map<std::string, int> m_UniformLocationCache;
+   int                                  m_MVPLocation = -1;
 
 public:
+   // Uniform buffer binding point of the FrameData block (res/shaders/includes/frame.shader)
+   static constexpr uint32_t FRAME_BLOCK_BINDING = 0;
+
    Shader(const std::string& filepath);
    ~Shader();
 
@@ -40,12 +45,32 @@ public:
    void SetUniform4f(const std::string& name, const glm::vec4& value);
    void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
 
+   // Same, by a location from GetUniformHandle, without looking the name up. For uniforms set every frame.
+   int  GetUniformHandle(const std::string& name) { return GetUniformLocation(name); }
+   void SetUniform1i(int location, int value);
+   void SetUniform1f(int location, float value);
+   void SetUniform2f(int location, const glm::vec2& value);
+   void SetUniform3f(int location, const glm::vec3& value);
+   void SetUniform4f(int location, const glm::vec4& value);
+   void SetUniformMat4f(int location, const glm::mat4& matrix);
+
+   // u_MVP, which every GameObject sets; looked up when the program is linked
+   int MVPLocation() const { return m_MVPLocation; }
+
+   // Startup cost of every shader built so far, logged once the first frame is up
+   static void LogSetupStats();
+
    // Declare the global memoized constructor
    DECLARE_GLOBAL_MEMOIZED_CONSTRUCTOR(Shader)
 
 private:
    ShaderProgramSource ParseShader(const std::string& filepath);
    uint32_t            CompileShader(uint32_t type, const std::string& source);
+   // Links the program from the on-disk binary cache when the driver has seen this exact source before, otherwise
+   // compiles it from source and stores the result for the next launch
    uint32_t            CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
-   uint32_t            GetUniformLocation(const std::string& name);
+   uint32_t            CompileProgram(const std::string& vertexShader, const std::string& fragmentShader);
+   int                 GetUniformLocation(const std::string& name);
+   // Binds the FrameData block and resolves the built-in uniform handles after the program is (re)linked
+   void                ResolveProgramInterface();
 };
@@ -0,0 +1,58 @@
+#include "SpatialIndex.h"
+#include "game_objects/SquareObject.h"
+
+#include <algorithm>
+
+uint64_t SpatialIndex::Key(int x, int y) {
+   return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+void SpatialIndex::Insert(SquareObject* object) {
+   cells[Key(object->tile_x, object->tile_y)].push_back(object);
+   size++;
+}
+
+void SpatialIndex::Remove(SquareObject* object) {
+   auto it = cells.find(Key(object->tile_x, object->tile_y));
+   if (it == cells.end()) {
+      return;
+   }
+   // keep insertion order inside the bucket so lookups stay deterministic
+   auto& cell  = it->second;
+   auto  found = std::remove(cell.begin(), cell.end(), object);
+   size -= cell.end() - found;
+   cell.erase(found, cell.end());
+}
+
+void SpatialIndex::Move(SquareObject* object, int old_x, int old_y) {
+   if (old_x == object->tile_x && old_y == object->tile_y) {
+      return;
+   }
+
+   auto it = cells.find(Key(old_x, old_y));
+   if (it == cells.end()) {
+      return;
+   }
+   auto& cell  = it->second;
+   auto  found = std::find(cell.begin(), cell.end(), object);
+   if (found == cell.end()) {
+      return;
+   }
+   cell.erase(found);
+   cells[Key(object->tile_x, object->tile_y)].push_back(object);
+}
+
+void SpatialIndex::Clear() {
+   cells.clear();
+   size = 0;
+}
+
+const std::vector<SquareObject*>& SpatialIndex::At(int x, int y) const {
+   static const std::vector<SquareObject*> empty;
+
+   auto it = cells.find(Key(x, y));
+   if (it == cells.end()) {
+      return empty;
+   }
+   return it->second;
+}
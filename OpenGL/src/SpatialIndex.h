@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class SquareObject;
+
+// Buckets every SquareObject in the world by the tile it occupies, so tile lookups don't have to walk
+// World::gameobjects. Objects are registered by World when they are added and keep their bucket up to date through
+// SquareObject::setTile.
+class SpatialIndex {
+public:
+   void Insert(SquareObject* object);
+   void Remove(SquareObject* object);
+   // Moves an object from the bucket at (old_x, old_y) to the bucket at its current tile. Objects that aren't indexed
+   // (e.g. ones still waiting in World::gameobjectstoadd) are left alone.
+   void Move(SquareObject* object, int old_x, int old_y);
+   void Clear();
+
+   const std::vector<SquareObject*>& At(int x, int y) const;
+   size_t                            Size() const { return size; }
+
+private:
+   static uint64_t Key(int x, int y);
+
+   std::unordered_map<uint64_t, std::vector<SquareObject*>> cells;
+   size_t                                                   size = 0;
+};
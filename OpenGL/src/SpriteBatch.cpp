@@ -0,0 +1,60 @@
+#include "SpriteBatch.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+
+#include <algorithm>
+
+SpriteBatch::SpriteBatch() {
+   shader = Shader::create(Renderer::ResPath() + "shaders/sprite.shader");
+   Reserve(1024);
+}
+
+void SpriteBatch::Reserve(size_t spriteCount) {
+   if (spriteCount <= capacity) {
+      return;
+   }
+   capacity = std::max(spriteCount, capacity * 2);
+
+   std::vector<uint32_t> indices;
+   indices.reserve(capacity * 6);
+   for (uint32_t i = 0; i < capacity; i++) {
+      uint32_t base = i * 4;
+      for (uint32_t offset : {0, 1, 2, 2, 3, 0}) {
+         indices.push_back(base + offset);
+      }
+   }
+
+   vb = std::make_shared<VertexBuffer>(capacity * 4 * sizeof(SpriteVertex), GL_DYNAMIC_DRAW);
+   VertexBufferLayout layout;
+   layout.Push<float>(2); // position
+   layout.Push<float>(2); // texCoord
+   layout.Push<float>(4); // tint
+   va = std::make_shared<VertexArray>(vb, layout);
+   ib = std::make_shared<IndexBuffer>(indices);
+}
+
+void SpriteBatch::Flush() {
+   if (builder.Empty()) {
+      return;
+   }
+
+   builder.Build();
+   Reserve(builder.SpriteCount());
+   vb->SetData(builder.Vertices());
+
+   shader->Bind();
+   shader->SetUniform1i("u_Texture", 0);
+   va->Bind();
+   ib->Bind();
+
+   GLCall(glActiveTexture(GL_TEXTURE0));
+   for (const auto& run : builder.Runs()) {
+      GLCall(glBindTexture(GL_TEXTURE_2D, run.texture));
+      GLCall(glDrawElements(GL_TRIANGLES, run.spriteCount * 6, GL_UNSIGNED_INT,
+                            (const void*)(uintptr_t)(run.firstSprite * 6 * sizeof(uint32_t))));
+      drawCalls++;
+   }
+   spritesDrawn += builder.SpriteCount();
+
+   builder.Clear();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+
+#include "Shader.h"
+#include "SpriteBatchBuilder.h"
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+
+// Streams all sprites of a draw layer into one vertex buffer and draws them with one call per run of a texture.
+class SpriteBatch {
+public:
+   SpriteBatch();
+
+   void Submit(const Sprite& sprite) { builder.Submit(sprite); }
+   // Draws the queued sprites with the camera from the FrameData uniform block
+   void Flush();
+
+   // Stats for the last flushed frame
+   uint32_t drawCalls     = 0;
+   uint32_t spritesDrawn  = 0;
+   void     ResetStats() { drawCalls = spritesDrawn = 0; }
+
+private:
+   void Reserve(size_t spriteCount);
+
+   SpriteBatchBuilder            builder;
+   size_t                        capacity = 0;
+   std::shared_ptr<Shader>       shader;
+   std::shared_ptr<VertexBuffer> vb;
+   std::shared_ptr<VertexArray>  va;
+   std::shared_ptr<IndexBuffer>  ib;
+};
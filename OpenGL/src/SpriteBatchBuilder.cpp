@@ -0,0 +1,58 @@
+#include "SpriteBatchBuilder.h"
+
+#include <array>
+#include <cmath>
+
+void SpriteBatchBuilder::Submit(const Sprite& sprite) {
+   sprites.push_back(sprite);
+}
+
+void SpriteBatchBuilder::Build() {
+   static const std::array<glm::vec2, 4> corners = {
+      glm::vec2(-0.5f, -0.5f),
+      glm::vec2(0.5f,  -0.5f),
+      glm::vec2(0.5f,  0.5f ),
+      glm::vec2(-0.5f, 0.5f ),
+   };
+   static const std::array<glm::vec2, 4> texCorners = {
+      glm::vec2(0.0f, 0.0f),
+      glm::vec2(1.0f, 0.0f),
+      glm::vec2(1.0f, 1.0f),
+      glm::vec2(0.0f, 1.0f),
+   };
+
+   vertices.clear();
+   vertices.reserve(sprites.size() * 4);
+   runs.clear();
+
+   for (uint32_t i = 0; i < sprites.size(); i++) {
+      const auto& sprite = sprites[i];
+
+      if (runs.empty() || runs.back().texture != sprite.texture) {
+         runs.push_back({sprite.texture, i, 0});
+      }
+      runs.back().spriteCount++;
+
+      // same model transform as CalculateMVP: translate * rotate * scale
+      float radians = glm::radians(sprite.rotation);
+      float c       = std::cos(radians) * sprite.scale;
+      float s       = std::sin(radians) * sprite.scale;
+      for (size_t corner = 0; corner < 4; corner++) {
+         const auto& p = corners[corner];
+         const auto& t = texCorners[corner];
+
+         SpriteVertex vertex;
+         vertex.position = sprite.position + glm::vec2(c * p.x - s * p.y, s * p.x + c * p.y);
+         vertex.texCoord = {sprite.uv.x + (sprite.uv.z - sprite.uv.x) * t.x,
+                            sprite.uv.y + (sprite.uv.w - sprite.uv.y) * t.y};
+         vertex.tint     = sprite.tint;
+         vertices.push_back(vertex);
+      }
+   }
+}
+
+void SpriteBatchBuilder::Clear() {
+   sprites.clear();
+   vertices.clear();
+   runs.clear();
+}
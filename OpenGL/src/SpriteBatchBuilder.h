@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// A textured, tinted quad in world space. Matches what a SquareObject used to draw on its own.
+struct Sprite {
+   uint32_t  texture; // GL texture name
+   glm::vec2 position;
+   float     rotation; // degrees
+   float     scale;
+   glm::vec4 tint;
+   glm::vec4 uv = {0.0f, 0.0f, 1.0f, 1.0f}; // sub-rectangle of the texture: u0, v0, u1, v1
+};
+
+struct SpriteVertex {
+   glm::vec2 position;
+   glm::vec2 texCoord;
+   glm::vec4 tint;
+};
+
+// A range of consecutive quads that all sample the same texture, i.e. one draw call.
+struct SpriteBatchRun {
+   uint32_t texture;
+   uint32_t firstSprite;
+   uint32_t spriteCount;
+};
+
+// CPU half of the sprite batch: collects the sprites of one draw layer and expands them into quad vertices, with one
+// run per stretch of consecutive sprites sharing a texture. Sprites are never reordered, since overlapping ones have to
+// be drawn in submission order; objects that share the texture atlas end up in the same run anyway. Doesn't touch GL,
+// so it can be checked headlessly (see tests/SpriteBatchBuilderTest.cpp).
+class SpriteBatchBuilder {
+public:
+   void Submit(const Sprite& sprite);
+   void Build();
+   void Clear();
+
+   bool                               Empty() const { return sprites.empty(); }
+   size_t                             SpriteCount() const { return sprites.size(); }
+   const std::vector<SpriteVertex>&   Vertices() const { return vertices; }
+   const std::vector<SpriteBatchRun>& Runs() const { return runs; }
+
+private:
+   std::vector<Sprite>         sprites;
+   std::vector<SpriteVertex>   vertices;
+   std::vector<SpriteBatchRun> runs;
+};
@@ -0,0 +1,112 @@
+#include "TaskPool.h"
+
+#include <algorithm>
+
+TaskPool::TaskPool(unsigned threads) {
+   if (threads == 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
+   }
+   for (unsigned i = 0; i < threads; i++) {
+      queues.push_back(std::make_unique<Queue>());
+   }
+   for (unsigned i = 1; i < threads; i++) {
+      workers.emplace_back([this, i] { WorkerLoop(i); });
+   }
+}
+
+TaskPool::~TaskPool() {
+   {
+      std::lock_guard lock(mutex);
+      stopping = true;
+   }
+   wake.notify_all();
+   for (auto& worker : workers) {
+      worker.join();
+   }
+}
+
+void TaskPool::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+   grain = std::max<size_t>(grain, 1);
+   if (workers.empty() || count <= grain) {
+      for (size_t begin = 0; begin < count; begin += grain) {
+         body(begin, std::min(count, begin + grain));
+      }
+      return;
+   }
+
+   size_t chunks = (count + grain - 1) / grain;
+   remaining     = chunks;
+   for (size_t chunk = 0; chunk < chunks; chunk++) {
+      auto& queue = *queues[chunk % queues.size()];
+      std::lock_guard lock(queue.mutex);
+      queue.ranges.push_back({chunk * grain, std::min(count, (chunk + 1) * grain)});
+   }
+   {
+      std::lock_guard lock(mutex);
+      this->body = &body;
+      generation++;
+   }
+   wake.notify_all();
+
+   Work(0, body);
+
+   // Workers still inside this job hold a reference to body
+   std::unique_lock lock(mutex);
+   done.wait(lock, [&] { return remaining == 0 && active == 0; });
+   this->body = nullptr;
+}
+
+bool TaskPool::Take(size_t self, std::pair<size_t, size_t>& range) {
+   {
+      auto&           own = *queues[self];
+      std::lock_guard lock(own.mutex);
+      if (!own.ranges.empty()) {
+         range = own.ranges.back();
+         own.ranges.pop_back();
+         return true;
+      }
+   }
+   for (size_t i = 1; i < queues.size(); i++) {
+      auto&           victim = *queues[(self + i) % queues.size()];
+      std::lock_guard lock(victim.mutex);
+      if (!victim.ranges.empty()) {
+         range = victim.ranges.front();
+         victim.ranges.pop_front();
+         return true;
+      }
+   }
+   return false;
+}
+
+void TaskPool::Work(size_t self, const std::function<void(size_t, size_t)>& body) {
+   std::pair<size_t, size_t> range;
+   while (Take(self, range)) {
+      body(range.first, range.second);
+      remaining--;
+   }
+}
+
+void TaskPool::WorkerLoop(size_t self) {
+   uint64_t seen = 0;
+   while (true) {
+      const std::function<void(size_t, size_t)>* job;
+      {
+         std::unique_lock lock(mutex);
+         wake.wait(lock, [&] { return stopping || (generation != seen && body); });
+         if (stopping) {
+            return;
+         }
+         seen = generation;
+         job  = body;
+         active++;
+      }
+
+      Work(self, *job);
+
+      {
+         std::lock_guard lock(mutex);
+         active--;
+      }
+      done.notify_all();
+   }
+}
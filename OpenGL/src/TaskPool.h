@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Fork-join thread pool for the tick's decide phase. ParallelFor splits an index range into chunks dealt round-robin
+// to one queue per thread; a thread takes chunks from the back of its own queue and, once that is empty, steals from
+// the front of the others', so uneven chunks even out. The calling thread works too, and ParallelFor returns once
+// every chunk is done.
+class TaskPool {
+public:
+   // `threads` counts the caller; 1 runs everything inline, 0 means one per hardware thread
+   explicit TaskPool(unsigned threads = 0);
+   ~TaskPool();
+
+   TaskPool(const TaskPool&)            = delete;
+   TaskPool& operator=(const TaskPool&) = delete;
+
+   // Calls body(begin, end) for consecutive ranges of at most `grain` indices covering [0, count)
+   void     ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+   unsigned Threads() const { return (unsigned)queues.size(); }
+
+private:
+   struct Queue {
+      std::mutex                              mutex;
+      std::deque<std::pair<size_t, size_t>> ranges;
+   };
+
+   void Work(size_t self, const std::function<void(size_t, size_t)>& body);
+   bool Take(size_t self, std::pair<size_t, size_t>& range);
+   void WorkerLoop(size_t self);
+
+   std::vector<std::unique_ptr<Queue>> queues; // [0] is the calling thread's
+   std::vector<std::thread>            workers;
+
+   std::mutex                                mutex;
+   std::condition_variable                   wake;
+   std::condition_variable                   done;
+   const std::function<void(size_t, size_t)>* body       = nullptr;
+   uint64_t                                  generation = 0;
+   unsigned                                  active     = 0; // workers inside the current job
+   std::atomic<size_t>                       remaining  = 0; // chunks not finished yet
+   bool                                      stopping   = false;
+};
@@ -1,4 +1,7 @@
 #include "Texture.h"
+#include "TextureAtlas.h"
+
+#define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
 #include <iostream>
@@ -10,10 +13,47 @@ Texture::Texture(const std::string& path)
    , m_Width(0)
    , m_Height(0)
    , m_BPP(0) {
+   if (auto region = TextureAtlas::Find(path)) {
+      m_Page   = region->page;
+      m_UV     = region->uv;
+      m_Width  = region->width;
+      m_Height = region->height;
+      m_BPP    = 4;
+      return;
+   }
+
    std::cout << "Initializing texture " << path << std::endl;
-   stbi_set_flip_vertically_on_load(1);
-   m_LocalBuffer = stbi_load(path.c_str(), &m_Width, &m_Height, &m_BPP, 4);
+   m_Pending = AssetLoader::DecodeImage(path);
+}
 
+Texture::Texture(int width, int height, const unsigned char* pixels)
+   : m_RendererID(0)
+   , m_LocalBuffer(nullptr)
+   , m_Width(width)
+   , m_Height(height)
+   , m_BPP(4) {
+   Upload(pixels);
+}
+
+bool Texture::IsReady() {
+   if (!m_Pending.valid()) {
+      return true;
+   }
+   if (!AssetLoader::IsReady(m_Pending)) {
+      return false;
+   }
+
+   auto image = m_Pending.get();
+   m_Pending  = {};
+   m_Width    = image->width;
+   m_Height   = image->height;
+   m_BPP      = 4;
+   // a failed decode still gets an (empty) texture name, like the synchronous path used to
+   Upload(image->ok() ? image->pixels.data() : nullptr);
+   return true;
+}
+
+void Texture::Upload(const unsigned char* pixels) {
    GLCall(glGenTextures(1, &m_RendererID));
    GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
 
@@ -22,23 +62,19 @@ Texture::Texture(const std::string& path)
    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
    GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
-   GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
+   GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
    GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-
-   if (m_LocalBuffer) {
-      stbi_image_free(m_LocalBuffer);
-   } else {
-      std::cerr << "Failed to load texture: " << path << std::endl;
-   }
 }
 
 Texture::~Texture() {
-   GLCall(glDeleteTextures(1, &m_RendererID));
+   if (m_RendererID != 0) {
+      GLCall(glDeleteTextures(1, &m_RendererID));
+   }
 }
 
 void Texture::Bind(uint32_t slot) const {
    GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-   GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+   GLCall(glBindTexture(GL_TEXTURE_2D, GetRendererID()));
 }
 
 void Texture::Unbind() const {
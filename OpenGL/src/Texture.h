@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Renderer.h"
+#include "AssetLoader.h"
 
 class Texture {
 private:
@@ -9,15 +10,32 @@ private:
    unsigned char*   m_LocalBuffer;
    int              m_Width, m_Height, m_BPP;
 
+   // Set when the image was packed into a TextureAtlas page; the texture is then just a region of that page
+   std::shared_ptr<Texture> m_Page;
+   glm::vec4                m_UV = {0.0f, 0.0f, 1.0f, 1.0f};
+
+   // Decode running on an AssetLoader worker; uploaded by the first IsReady call after it finishes
+   std::shared_future<std::shared_ptr<const DecodedImage>> m_Pending;
+
+   void Upload(const unsigned char* pixels);
+
 public:
+   // Images that aren't in the TextureAtlas are decoded in the background; see IsReady
    Texture(const std::string& path);
+   // RGBA8 texture from pixels already in memory
+   Texture(int width, int height, const unsigned char* pixels);
    ~Texture();
 
    void Bind(uint32_t slot = 0) const;
    void Unbind() const;
 
-   inline int GetWidth() const { return m_Width; }
-   inline int GetHeight() const { return m_Height; }
+   // False while the image is still being decoded. Uploads it once the decode is done, so call from the GL thread.
+   bool             IsReady();
+   // 0 until IsReady returned true
+   inline uint32_t  GetRendererID() const { return m_Page ? m_Page->GetRendererID() : (uint32_t)m_RendererID; }
+   inline glm::vec4 GetUV() const { return m_UV; }
+   inline int       GetWidth() const { return m_Width; }
+   inline int       GetHeight() const { return m_Height; }
 
    Texture(const Texture&)             = delete;
    Texture(Texture&& other)            = default;
@@ -0,0 +1,117 @@
+#include "TextureAtlas.h"
+#include "Texture.h"
+#include "AssetLoader.h"
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Space left around every image. The border pixels are repeated into it so linear filtering never samples a
+// neighbouring sprite.
+const int PADDING = 2;
+
+void blitWithExtrudedBorder(std::vector<unsigned char>& page, int pageWidth, const DecodedImage& image, int x, int y) {
+   for (int row = -PADDING; row < image.height + PADDING; row++) {
+      int srcRow = std::clamp(row, 0, image.height - 1);
+      for (int col = -PADDING; col < image.width + PADDING; col++) {
+         int srcCol = std::clamp(col, 0, image.width - 1);
+         std::memcpy(&page[((size_t)(y + row) * pageWidth + (x + col)) * 4],
+                     &image.pixels[((size_t)srcRow * image.width + srcCol) * 4], 4);
+      }
+   }
+}
+
+} // namespace
+
+std::unordered_map<std::string, AtlasRegion>& TextureAtlas::regions() {
+   static std::unordered_map<std::string, AtlasRegion> regions;
+   return regions;
+}
+
+bool TextureAtlas::Build(const std::string& directory) {
+   Clear();
+
+   // Decode every image at once on the asset loader's workers, then pack on this thread
+   std::vector<std::shared_future<std::shared_ptr<const DecodedImage>>> decoding;
+   for (const auto& entry : fs::directory_iterator(directory)) {
+      if (entry.path().extension() == ".png") {
+         decoding.push_back(AssetLoader::DecodeImage(entry.path().string()));
+      }
+   }
+   std::vector<std::shared_ptr<const DecodedImage>> images;
+   for (auto& future : decoding) {
+      if (auto image = future.get(); image->ok()) {
+         images.push_back(image);
+      }
+   }
+
+   int maxSize = 0;
+   GLCall(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize));
+
+   std::vector<stbrp_rect> rects(images.size());
+   for (size_t i = 0; i < images.size(); i++) {
+      rects[i]   = {};
+      rects[i].id = (int)i;
+      rects[i].w  = images[i]->width + PADDING * 2;
+      rects[i].h  = images[i]->height + PADDING * 2;
+   }
+
+   // Grow the page until everything fits
+   int  size   = 256;
+   bool packed = false;
+   while (!packed && size <= maxSize) {
+      std::vector<stbrp_node> nodes(size);
+      stbrp_context           context;
+      stbrp_init_target(&context, size, size, nodes.data(), (int)nodes.size());
+      packed = stbrp_pack_rects(&context, rects.data(), (int)rects.size()) == 1;
+      if (!packed) {
+         size *= 2;
+      }
+   }
+
+   if (packed) {
+      std::vector<unsigned char> page((size_t)size * size * 4, 0);
+      for (const auto& rect : rects) {
+         blitWithExtrudedBorder(page, size, *images[rect.id], rect.x + PADDING, rect.y + PADDING);
+      }
+
+      auto texture = std::make_shared<Texture>(size, size, page.data());
+      for (const auto& rect : rects) {
+         const auto& image = *images[rect.id];
+         float       u0    = (float)(rect.x + PADDING) / size;
+         float       v0    = (float)(rect.y + PADDING) / size;
+         float       u1    = (float)(rect.x + PADDING + image.width) / size;
+         float       v1    = (float)(rect.y + PADDING + image.height) / size;
+         AtlasRegion region{texture, {u0, v0, u1, v1}, image.width, image.height};
+         regions()[fs::path(image.path).lexically_normal().string()] = region;
+      }
+      std::cout << "Packed " << rects.size() << " textures into a " << size << "x" << size << " atlas" << std::endl;
+   } else {
+      std::cerr << "Textures in " << directory << " don't fit in a " << maxSize << "x" << maxSize << " atlas"
+                << std::endl;
+   }
+
+   return packed;
+}
+
+std::optional<AtlasRegion> TextureAtlas::Find(const std::string& path) {
+   auto it = regions().find(fs::path(path).lexically_normal().string());
+   if (it == regions().end()) {
+      return std::nullopt;
+   }
+   return it->second;
+}
+
+void TextureAtlas::Clear() {
+   regions().clear();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+class Texture;
+
+// Where a packed image lives inside the atlas page
+struct AtlasRegion {
+   std::shared_ptr<Texture> page;
+   glm::vec4                uv; // u0, v0, u1, v1
+   int                      width;
+   int                      height;
+};
+
+// Packs every PNG of a directory into a single texture page at startup so all sprites can be drawn with one texture
+// bound. Texture::create resolves paths that were packed to their region of the page.
+class TextureAtlas {
+public:
+   // Loads and packs all *.png files in `directory`. Returns false (and leaves the atlas empty) if they don't fit in
+   // the largest texture the driver supports.
+   static bool                       Build(const std::string& directory);
+   static std::optional<AtlasRegion> Find(const std::string& path);
+   static void                       Clear();
+
+private:
+   static std::unordered_map<std::string, AtlasRegion>& regions();
+};
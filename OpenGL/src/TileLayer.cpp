@@ -0,0 +1,210 @@
+#include "TileLayer.h"
+#include "Renderer.h"
+#include "VertexBufferLayout.h"
+#include "World.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+TileLayer::TileLayer() {
+   shader      = Shader::create(Renderer::ResPath() + "shaders/tile.shader");
+   chunkShader = Shader::create(Renderer::ResPath() + "shaders/chunk.shader");
+
+   std::array<float, 16> quad = {
+      // position    texCoord
+      -0.5f, -0.5f, 0.0f, 0.0f,
+      0.5f,  -0.5f, 1.0f, 0.0f,
+      0.5f,  0.5f,  1.0f, 1.0f,
+      -0.5f, 0.5f,  0.0f, 1.0f,
+   };
+   std::array<uint32_t, 6> indices = {0, 1, 2, 2, 3, 0};
+
+   quadVb = VertexBuffer::create(quad);
+   ib     = IndexBuffer::create(indices);
+
+   VertexBufferLayout quadLayout;
+   quadLayout.Push<float>(2); // position
+   quadLayout.Push<float>(2); // texCoord
+   chunkVa = std::make_shared<VertexArray>(quadVb, quadLayout);
+
+   // Holds one chunk's tiles at a time, refilled for every chunk that is re-rendered
+   va         = std::make_shared<VertexArray>(quadVb, quadLayout);
+   instanceVb = std::make_shared<VertexBuffer>(CHUNK_SIZE * CHUNK_SIZE * sizeof(TileInstance), GL_DYNAMIC_DRAW);
+   VertexBufferLayout instanceLayout;
+   instanceLayout.Push<float>(2); // tile position
+   instanceLayout.Push<float>(4); // uv rectangle
+   instanceLayout.Push<float>(4); // tint
+   va->AddInstanceBuffer(instanceVb, instanceLayout, 2);
+}
+
+std::pair<int, int> TileLayer::ChunkOf(glm::vec2 position) {
+   return {(int)std::floor((position.x + 0.5f) / CHUNK_SIZE), (int)std::floor((position.y + 0.5f) / CHUNK_SIZE)};
+}
+
+void TileLayer::Attach(uint32_t instance) {
+   auto& chunk = chunks[ChunkOf(instances[instance].position)];
+   chunk.slots.push_back(instance);
+   chunk.dirty = true;
+}
+
+void TileLayer::Detach(uint32_t instance) {
+   auto  it    = chunks.find(ChunkOf(instances[instance].position));
+   auto& slots = it->second.slots;
+   std::erase(slots, instance);
+   it->second.dirty = true;
+   if (slots.empty()) {
+      chunks.erase(it);
+   }
+}
+
+void TileLayer::Sync() {
+   if (mapVersion != World::mapVersion) {
+      // every tile of the old map is gone
+      mapVersion = World::mapVersion;
+      instances.clear();
+      freeSlots.clear();
+      chunks.clear();
+      World::releasedTileSlots.clear();
+      texture = 0;
+   }
+
+   for (uint32_t slot : World::releasedTileSlots) {
+      if (slot >= instances.size()) {
+         continue;
+      }
+      Detach(slot);
+      // far outside any chunk; it belongs to none until it is reused
+      instances[slot].position = glm::vec2(-1e9f);
+      freeSlots.push_back(slot);
+   }
+   World::releasedTileSlots.clear();
+}
+
+bool TileLayer::Submit(uint32_t& slot, uint32_t texture, const TileInstance& instance) {
+   Sync();
+
+   if (texture != this->texture) {
+      if (!instances.empty()) {
+         return false;
+      }
+      // the first tile decides which atlas page the layer draws from
+      this->texture = texture;
+   }
+
+   submitted = true;
+   if (slot >= instances.size()) {
+      if (freeSlots.empty()) {
+         slot = (uint32_t)instances.size();
+         instances.push_back(instance);
+      } else {
+         slot = freeSlots.back();
+         freeSlots.pop_back();
+         instances[slot] = instance;
+      }
+      Attach(slot);
+   } else if (instances[slot] != instance) {
+      // both the chunk the tile was in and the one it is in now need redrawing
+      Detach(slot);
+      instances[slot] = instance;
+      Attach(slot);
+   }
+   return true;
+}
+
+void TileLayer::RenderChunk(std::pair<int, int> key, Chunk& chunk) {
+   if (!chunk.target) {
+      chunk.target = std::make_unique<Framebuffer>(CHUNK_SIZE * TILE_PIXELS, CHUNK_SIZE * TILE_PIXELS);
+   }
+
+   // world rectangle covered by the chunk; tiles are centred on integer coordinates
+   float left   = key.first * CHUNK_SIZE - 0.5f;
+   float bottom = key.second * CHUNK_SIZE - 0.5f;
+
+   chunk.target->Bind();
+   GLCall(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+   GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+   // Only the chunk's own tiles are uploaded and drawn
+   chunkInstances.clear();
+   for (uint32_t slot : chunk.slots) {
+      chunkInstances.push_back(instances[slot]);
+   }
+   instanceVb->SetData(chunkInstances);
+   tilesUploaded += (uint32_t)chunkInstances.size();
+
+   shader->SetUniformMat4f(shader->MVPLocation(),
+                           glm::ortho(left, left + CHUNK_SIZE, bottom, bottom + CHUNK_SIZE, -1.0f, 1.0f));
+   GLCall(glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr, (GLsizei)chunkInstances.size()));
+   drawCalls++;
+   chunksRendered++;
+
+   chunk.dirty = false;
+}
+
+void TileLayer::Flush(const glm::mat4& viewProjection) {
+   Sync();
+
+   // Only the layer holding the tiles submits anything, and only while some are on screen
+   if (!submitted) {
+      return;
+   }
+   submitted = false;
+
+   // Re-render the chunks that changed
+   bool anyDirty = std::any_of(chunks.begin(), chunks.end(), [](const auto& chunk) { return chunk.second.dirty; });
+   if (anyDirty) {
+      GLint viewport[4];
+      GLCall(glGetIntegerv(GL_VIEWPORT, viewport));
+      // tiles don't overlap, so write them straight into the chunk without blending against the cleared background
+      GLCall(glDisable(GL_BLEND));
+
+      shader->Bind();
+      shader->SetUniform1i("u_Texture", 0);
+      va->Bind();
+      ib->Bind();
+      GLCall(glActiveTexture(GL_TEXTURE0));
+      GLCall(glBindTexture(GL_TEXTURE_2D, texture));
+
+      for (auto& [key, chunk] : chunks) {
+         if (chunk.dirty) {
+            RenderChunk(key, chunk);
+         }
+      }
+
+      GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+      GLCall(glViewport(viewport[0], viewport[1], viewport[2], viewport[3]));
+      GLCall(glEnable(GL_BLEND));
+   }
+
+   // Visible world rectangle
+   glm::mat4 inverse = glm::inverse(viewProjection);
+   glm::vec4 corner0 = inverse * glm::vec4(-1.0f, -1.0f, 0.0f, 1.0f);
+   glm::vec4 corner1 = inverse * glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);
+   glm::vec2 viewMin = glm::min(glm::vec2(corner0.x, corner0.y), glm::vec2(corner1.x, corner1.y));
+   glm::vec2 viewMax = glm::max(glm::vec2(corner0.x, corner0.y), glm::vec2(corner1.x, corner1.y));
+
+   chunkShader->Bind();
+   chunkShader->SetUniform1i("u_Texture", 0);
+   chunkVa->Bind();
+   ib->Bind();
+   GLCall(glActiveTexture(GL_TEXTURE0));
+
+   for (auto& [key, chunk] : chunks) {
+      glm::vec2 chunkMin(key.first * CHUNK_SIZE - 0.5f, key.second * CHUNK_SIZE - 0.5f);
+      glm::vec2 chunkMax = chunkMin + glm::vec2(CHUNK_SIZE);
+      if (!chunk.target || chunkMax.x < viewMin.x || chunkMin.x > viewMax.x || chunkMax.y < viewMin.y ||
+          chunkMin.y > viewMax.y) {
+         continue;
+      }
+
+      glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3((chunkMin + chunkMax) * 0.5f, 0.0f));
+      model           = glm::scale(model, glm::vec3(CHUNK_SIZE, CHUNK_SIZE, 1.0f));
+      chunkShader->SetUniformMat4f(chunkShader->MVPLocation(), viewProjection * model);
+      GLCall(glBindTexture(GL_TEXTURE_2D, chunk.target->GetTextureID()));
+      GLCall(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
+      drawCalls++;
+      chunksDrawn++;
+   }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Shader.h"
+#include "VertexBuffer.h"
+#include "VertexArray.h"
+#include "IndexBuffer.h"
+#include "Framebuffer.h"
+
+// Per-instance data of one tile quad
+struct TileInstance {
+   glm::vec2 position;
+   glm::vec4 uv; // sub-rectangle of the atlas page: u0, v0, u1, v1
+   glm::vec4 tint;
+
+   bool operator==(const TileInstance&) const = default;
+};
+
+// Draws every tile of the map. Each tile owns an instance slot, handed out on its first Submit. A destroyed tile hands
+// its slot back through World::releasedTileSlots (see ChunkStreamer), and reloading the map releases all of them.
+//
+// The tiles are rendered (as instances of one shared quad, with the Lab tint mixing) into an offscreen texture per
+// CHUNK_SIZE x CHUNK_SIZE chunk of the map. A chunk is only re-rendered when one of its tiles changed, and then only
+// its own tiles are uploaded and drawn; every frame just draws the chunk textures that are on screen.
+class TileLayer {
+public:
+   TileLayer();
+
+   // Updates the tile in `slot` (UINT32_MAX for a tile that doesn't have one yet) for this frame. Only tiles on screen
+   // need to submit; the others keep their last state. Returns false if the tile's texture isn't on the atlas page
+   // the layer draws from; the caller has to draw that tile some other way.
+   bool Submit(uint32_t& slot, uint32_t texture, const TileInstance& instance);
+   void Flush(const glm::mat4& viewProjection);
+
+   // Stats for the last flushed frame
+   uint32_t drawCalls      = 0;
+   uint32_t tilesUploaded  = 0;
+   uint32_t chunksDrawn    = 0;
+   uint32_t chunksRendered = 0;
+   void     ResetStats() { drawCalls = tilesUploaded = chunksDrawn = chunksRendered = 0; }
+
+private:
+   // Side length of a chunk in tiles, and the resolution a tile is cached at (about its size on screen at the default
+   // camera zoom)
+   static constexpr int CHUNK_SIZE  = 8;
+   static constexpr int TILE_PIXELS = 64;
+
+   struct Chunk {
+      std::unique_ptr<Framebuffer> target;
+      bool                         dirty = true;
+      // instance slots of the tiles in the chunk; the chunk and its texture are dropped when the last tile leaves
+      std::vector<uint32_t>        slots;
+   };
+
+   // Add/remove an instance to/from the chunk its position is in
+   void Attach(uint32_t instance);
+   void Detach(uint32_t instance);
+   // Drops everything when the map was reloaded and frees the slots of tiles destroyed since the last call
+   void Sync();
+   void RenderChunk(std::pair<int, int> key, Chunk& chunk);
+
+   static std::pair<int, int> ChunkOf(glm::vec2 position);
+
+   std::vector<TileInstance>            instances;      // indexed by slot
+   std::vector<uint32_t>                freeSlots;      // released instances, parked off-screen until they are reused
+   std::vector<TileInstance>            chunkInstances; // the instances of the chunk being rendered
+   bool                                 submitted  = false;
+   uint32_t                             mapVersion = 0;
+   uint32_t                             texture    = 0;
+   std::map<std::pair<int, int>, Chunk> chunks;
+   std::shared_ptr<Shader>              shader;
+   std::shared_ptr<Shader>              chunkShader;
+   std::shared_ptr<VertexBuffer>        quadVb;
+   std::shared_ptr<VertexBuffer>        instanceVb;
+   std::shared_ptr<VertexArray>         va;
+   std::shared_ptr<VertexArray>         chunkVa;
+   std::shared_ptr<IndexBuffer>         ib;
+};
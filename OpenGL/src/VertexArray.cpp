@@ -16,15 +16,28 @@ VertexArray::~VertexArray() {
 }
 
 void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout) {
+   AddAttributes(vb, layout, 0, 0);
+}
+
+void VertexArray::AddInstanceBuffer(std::shared_ptr<VertexBuffer> vbp, const VertexBufferLayout& layout,
+                                    uint32_t firstAttribute) {
+   vb.push_back(vbp);
+   AddAttributes(*vbp, layout, firstAttribute, 1);
+}
+
+void VertexArray::AddAttributes(const VertexBuffer& vb, const VertexBufferLayout& layout, uint32_t firstAttribute,
+                                uint32_t divisor) {
    Bind();
    vb.Bind();
    const auto& elements = layout.GetElements();
    uintptr_t   offset   = 0;
    for (uint32_t i = 0; i < elements.size(); i++) {
-      const auto& element = elements[i];
-      GLCall(glEnableVertexAttribArray(i));
-      GLCall(glVertexAttribPointer(i, element.count, element.type, element.normalized, layout.GetStride(),
+      const auto& element   = elements[i];
+      uint32_t    attribute = firstAttribute + i;
+      GLCall(glEnableVertexAttribArray(attribute));
+      GLCall(glVertexAttribPointer(attribute, element.count, element.type, element.normalized, layout.GetStride(),
                                    (const void*)offset));
+      GLCall(glVertexAttribDivisor(attribute, divisor));
       offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
    }
 }
@@ -14,6 +14,9 @@ private:
    wrap_t<uint32_t>                           m_RendererID;
    std::vector<std::shared_ptr<VertexBuffer>> vb;
 
+   void AddAttributes(const VertexBuffer& vb, const VertexBufferLayout& layout, uint32_t firstAttribute,
+                      uint32_t divisor);
+
 public:
    VertexArray(std::shared_ptr<VertexBuffer> vb, const VertexBufferLayout& layout);
 
@@ -33,6 +36,9 @@ public:
    ~VertexArray();
 
    void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+   // Adds a buffer whose attributes advance once per instance instead of once per vertex. Its attributes are numbered
+   // from firstAttribute, which must come after the attributes of the per-vertex buffers.
+   void AddInstanceBuffer(std::shared_ptr<VertexBuffer> vbp, const VertexBufferLayout& layout, uint32_t firstAttribute);
 
    void Bind() const;
    void Unbind() const;
@@ -6,10 +6,13 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <type_traits>
+#include <algorithm>
 
 class VertexBuffer {
 private:
    wrap_t<uint32_t> m_RendererID;
+   size_t           m_Size  = 0;
+   uint32_t         m_Usage = GL_STATIC_DRAW;
 
 public:
    template <typename Container>
@@ -17,9 +20,42 @@ public:
       using T = typename Container::value_type;
       static_assert(std::is_trivially_copyable_v<T>, "Data must be trivially copyable");
 
+      m_Size = data.size() * sizeof(T);
       GLCall(glGenBuffers(1, &m_RendererID));
       GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-      GLCall(glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(T), data.data(), GL_STATIC_DRAW));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, data.data(), GL_STATIC_DRAW));
+   }
+
+   // Uninitialized buffer of `size` bytes, meant to be filled with SetData every frame
+   VertexBuffer(size_t size, uint32_t usage)
+      : m_Size(size)
+      , m_Usage(usage) {
+      GLCall(glGenBuffers(1, &m_RendererID));
+      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+   }
+
+   // Replaces the contents of the buffer, growing it if needed. The old storage is orphaned first so the driver
+   // doesn't have to wait for draws that are still reading it.
+   template <typename Container>
+   void SetData(const Container& data) {
+      using T = typename Container::value_type;
+      static_assert(std::is_trivially_copyable_v<T>, "Data must be trivially copyable");
+
+      size_t size = data.size() * sizeof(T);
+      m_Size      = std::max(m_Size, size);
+      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+      GLCall(glBufferData(GL_ARRAY_BUFFER, m_Size, nullptr, m_Usage));
+      GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data.data()));
+   }
+
+   // Overwrites `count` elements starting at element `first` in place. The buffer must already be large enough.
+   template <typename T>
+   void SetSubData(size_t first, const T* data, size_t count) {
+      static_assert(std::is_trivially_copyable_v<T>, "Data must be trivially copyable");
+
+      GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+      GLCall(glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(T), count * sizeof(T), data));
    }
 
    VertexBuffer(const VertexBuffer&)             = delete;
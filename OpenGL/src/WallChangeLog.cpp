@@ -0,0 +1,48 @@
+#include "WallChangeLog.h"
+
+#include <algorithm>
+
+WallChangeLog::Reader WallChangeLog::AddReader() {
+   auto removed = std::find(cursors.begin(), cursors.end(), REMOVED);
+   if (removed != cursors.end()) {
+      *removed = End();
+      return (Reader)(removed - cursors.begin());
+   }
+   cursors.push_back(End());
+   return cursors.size() - 1;
+}
+
+void WallChangeLog::RemoveReader(Reader reader) {
+   cursors[reader] = REMOVED;
+}
+
+void WallChangeLog::Push(glm::ivec2 tile) {
+   // Nobody could ever read it
+   if (std::all_of(cursors.begin(), cursors.end(), [](size_t cursor) { return cursor == REMOVED; })) {
+      return;
+   }
+   entries.push_back(tile);
+}
+
+std::span<const glm::ivec2> WallChangeLog::Read(Reader reader) {
+   // Forget what every reader has seen before handing out the rest
+   size_t oldest = *std::min_element(cursors.begin(), cursors.end());
+   if (oldest != REMOVED && oldest > dropped) {
+      entries.erase(entries.begin(), entries.begin() + (oldest - dropped));
+      dropped = oldest;
+   }
+
+   std::span<const glm::ivec2> unread(entries.begin() + (cursors[reader] - dropped), entries.end());
+   cursors[reader] = End();
+   return unread;
+}
+
+void WallChangeLog::Clear() {
+   dropped += entries.size();
+   entries.clear();
+   for (auto& cursor : cursors) {
+      if (cursor != REMOVED) {
+         cursor = End();
+      }
+   }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Tiles whose wall was destroyed or streamed in or out, oldest first. Systems that cache wall geometry hold a reader
+// and only process the entries it hasn't seen yet. Entries every reader has seen are dropped, so the log stays small
+// however many chunks a session streams.
+class WallChangeLog {
+public:
+   using Reader = size_t;
+
+   // New readers start at the end of the log
+   Reader AddReader();
+   void   RemoveReader(Reader reader);
+
+   void Push(glm::ivec2 tile);
+   bool HasUnread(Reader reader) const { return cursors[reader] < End(); }
+   // The entries `reader` hasn't seen yet, which count as seen afterwards. Valid until the next Push or Read.
+   std::span<const glm::ivec2> Read(Reader reader);
+   // Drops every entry, for a new map; readers rebuild from the map itself
+   void Clear();
+
+private:
+   static constexpr size_t REMOVED = SIZE_MAX;
+
+   size_t End() const { return dropped + entries.size(); }
+
+   std::vector<glm::ivec2> entries;
+   size_t                  dropped = 0; // entries removed from the front so far
+   std::vector<size_t>     cursors;     // per reader, counted from the first entry ever pushed
+};
@@ -1,9 +1,16 @@
 #include <iostream>
+#include <filesystem>
 #include <fstream>
 #include "World.h"
 #include <algorithm>
+#include <cmath>
 
 #include "Renderer.h"
+#include "MapFile.h"
+#include "FixedClock.h"
+#include "Input.h"
+#include "xxhash.h"
+#include "TaskPool.h"
 #include "game_objects/Player.h"
 #include "game_objects/Background.h"
 #include "game_objects/Camera.h"
@@ -12,116 +19,283 @@
 #include "game_objects/enemies/Turret.h"
 #include "game_objects/Mine.h"
 
-std::vector<std::shared_ptr<GameObject>> World::gameobjects      = {};
-std::vector<std::unique_ptr<GameObject>> World::gameobjectstoadd = {};
-float                                    World::timeSpeed        = 1.0f;
-bool                                     World::settingTimeSpeed = false;
-bool                                     World::shouldTick       = false;
+// Before gameobjects: tiles destroyed with it at exit still hand their slots back, and Fog its wall change reader
+std::vector<uint32_t>                    World::releasedTileSlots  = {};
+WallChangeLog                            World::wallChanges        = {};
+std::vector<std::shared_ptr<GameObject>> World::gameobjects        = {};
+std::vector<std::unique_ptr<GameObject>> World::gameobjectstoadd   = {};
+SpatialIndex                             World::spatialIndex       = {};
+EntityStore                              World::entities           = {};
+uint32_t                                 World::mapVersion         = 0;
+size_t                                   World::streamingThreshold = 256 * 256;
+ChunkStreamer                            World::streamer           = {};
+FlowField                                World::flowField          = {};
+DangerField                              World::danger             = {};
+unsigned                                 World::tickThreads        = 0;
+std::mt19937                             World::rng                = {};
+float                                    World::timeSpeed          = 1.0f;
+bool                                     World::settingTimeSpeed   = false;
+bool                                     World::shouldTick         = false;
+bool                                     World::headless           = false;
 
-void World::LoadMap(const std::string& map_path) {
-   gameobjects.clear();
+std::array<std::vector<GameObject*>, (size_t)DrawPriority::UI + 1> World::drawLayers      = {};
+std::array<std::vector<GameObject*>, (size_t)DrawPriority::UI + 1> World::unindexedLayers = {};
+uint32_t                                                          World::renderedObjects = 0;
+uint32_t                                                          World::culledObjects   = 0;
 
-   std::ifstream file(Renderer::ResPath() + map_path);
+namespace {
+// SquareObjects found on screen this frame, per draw layer. Kept between frames to reuse the allocations.
+std::array<std::vector<GameObject*>, (size_t)DrawPriority::UI + 1> visibleLayers;
+// Objects taking part in the current tick, in draw layer order
+std::vector<GameObject*> ticking;
+std::unique_ptr<TaskPool> tickPool;
+// Steps since the last tick, see World::Step
+int stepsSinceTick = 0;
+} // namespace
 
-   if (!file.is_open()) {
-      std::cerr << "Error opening file: " << map_path << std::endl;
+void World::AddObject(std::shared_ptr<GameObject> object) {
+   if (auto square = dynamic_cast<SquareObject*>(object.get())) {
+      spatialIndex.Insert(square);
+      object->square = square;
+   } else {
+      unindexedLayers[(size_t)object->drawPriority].push_back(object.get());
+   }
+   object->handle = entities.Insert(object.get());
+   drawLayers[(size_t)object->drawPriority].push_back(object.get());
+   for (auto* child : object->children()) {
+      drawLayers[(size_t)child->drawPriority].push_back(child);
+      unindexedLayers[(size_t)child->drawPriority].push_back(child);
    }
+   gameobjects.push_back(std::move(object));
+}
 
-   std::vector<std::string> lines;
-   std::string              line;
+void World::LoadMap(const std::string& map_path) {
+   gameobjects.clear();
+   spatialIndex.Clear();
+   entities.Clear();
+   for (auto& layer : drawLayers) {
+      layer.clear();
+   }
+   for (auto& layer : unindexedLayers) {
+      layer.clear();
+   }
+   wallChanges.Clear();
+   streamer.Clear();
+   mapVersion++;
+   stepsSinceTick = 0;
 
-   // Read all lines into a vector
-   while (std::getline(file, line)) {
-      lines.push_back(std::move(line));
+   // Binary maps are used straight from the mapping; ASCII ones are parsed into the same arrays first
+   // Generated maps usually live outside res, so absolute paths are taken as they are
+   std::string path = std::filesystem::path(map_path).is_absolute() ? map_path : Renderer::ResPath() + map_path;
+   if (map_path.ends_with(".sbm")) {
+      if (auto mapped = MappedMap::Open(path)) {
+         SpawnMap(mapped->view());
+      } else {
+         std::cerr << "Error opening file: " << map_path << std::endl;
+      }
+      return;
    }
 
-   size_t total_rows = lines.size();
+   std::ifstream file(path);
+   if (!file.is_open()) {
+      std::cerr << "Error opening file: " << map_path << std::endl;
+   }
+   SpawnMap(MapFile::ParseText(file).view());
+}
 
-   for (size_t row = 0; row < total_rows; ++row) {
-      for (unsigned long x = 0; x < lines[row].length(); ++x) {
-         char   c = lines[row][x];
-         size_t y = total_rows - row;
-         if (c != '\n') {
-            if (c == 'b') { // Background
-               gameobjects.push_back(std::make_shared<Background>(Background("Background")));
-            }
-            if (c == 'p') { // player
-               gameobjects.push_back(std::make_shared<Player>(Player("Coolbox", (float)x, (float)y)));
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Floor", (float)x, (float)y)));
-            }
-            if (c == 'f') { // floor
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Floor", (float)x, (float)y)));
-            }
-            if (c == 'w') { // wall
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Wall", true, false, (float)x, (float)y)));
-            }
-            if (c == 'W') { // wall
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Wall", true, true, (float)x, (float)y)));
-            }
-            if (c == 'e') { // enemy Bomber
-               gameobjects.push_back(std::make_shared<Bomber>(Bomber("bomber", (float)x, (float)y)));
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Floor", (float)x, (float)y)));
-            }
-            if (c == 't') { // Turret
-               gameobjects.push_back(std::make_shared<Turret>(Turret("turret", (float)x, (float)y)));
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Floor", (float)x, (float)y)));
-            }
-            if (c == 'm') { // Mine
-               gameobjects.push_back(std::make_shared<Mine>(Mine("mine", (float)x, (float)y)));
-               gameobjects.push_back(std::make_shared<Tile>(Tile("Floor", (float)x, (float)y)));
+void World::SpawnMap(const MapView& map) {
+   bool streamed = map.tiles.size() > streamingThreshold;
+   if (streamed) {
+      streamer.Load(map);
+   } else {
+      for (uint32_t row = 0; row < map.header.height; ++row) {
+         for (uint32_t column = 0; column < map.header.width; ++column) {
+            float x = (float)(map.header.originX + (int32_t)column);
+            float y = (float)(map.header.originY + (int32_t)row);
+            switch (map.at(column, row)) {
+            case TileKind::Floor: AddObject(std::make_shared<Tile>(Tile("Floor", x, y))); break;
+            case TileKind::Wall: AddObject(std::make_shared<Tile>(Tile("Wall", true, false, x, y))); break;
+            case TileKind::UnbreakableWall:
+               AddObject(std::make_shared<Tile>(Tile("Wall", true, true, x, y)));
+               break;
+            case TileKind::Empty: break;
             }
          }
       }
    }
-}
 
-void sortGameObjectsByPriority(std::vector<std::unique_ptr<GameObject>>& gameObjects) {
-   std::sort(gameObjects.begin(), gameObjects.end(),
-             [](const std::unique_ptr<GameObject>& a, const std::unique_ptr<GameObject>& b) {
-                return a->drawPriority < b->drawPriority;
-             });
-}
+   for (const auto& spawn : map.spawns) {
+      float x = (float)spawn.x;
+      float y = (float)spawn.y;
+      switch (spawn.kind) {
+      case SpawnKind::Background: AddObject(std::make_shared<Background>(Background("Background"))); break;
+      case SpawnKind::Player: AddObject(std::make_shared<Player>(Player("Coolbox", x, y))); break;
+      case SpawnKind::Bomber: AddObject(std::make_shared<Bomber>(Bomber("bomber", x, y))); break;
+      case SpawnKind::Turret: AddObject(std::make_shared<Turret>(Turret("turret", x, y))); break;
+      case SpawnKind::Mine: AddObject(std::make_shared<Mine>(Mine("mine", x, y))); break;
+      }
+   }
 
-void sortGameObjectsByPriority(std::vector<GameObject*>& gameObjects) {
-   std::sort(gameObjects.begin(), gameObjects.end(),
-             [](const GameObject* a, const GameObject* b) { return a->drawPriority < b->drawPriority; });
+   if (streamed) {
+      if (auto player = getFirst<Player>()) {
+         streamer.Update(player->position);
+      }
+   }
 }
 
-
 void World::UpdateObjects() {
-   auto objects = get_gameobjects();
-   sortGameObjectsByPriority(objects);
+   for (auto& layer : drawLayers) {
+      for (auto* gameobject : layer) {
+         if (!IsFrozen(*gameobject)) {
+            gameobject->update();
+         }
+      }
+   }
 
-   for (auto& gameobject : objects) {
-      gameobject->update();
+   // stream chunks around the player; tiles of unloaded chunks are destroyed below
+   if (streamer.Active()) {
+      if (auto player = getFirst<Player>()) {
+         streamer.Update(player->position);
+      }
    }
 
    // erase dead objects
    // ------------------
-   std::erase_if(World::gameobjects, [](const auto& gameobject) { return gameobject->ShouldDestroy; });
+   bool anyDestroyed = false;
+   for (auto& gameobject : gameobjects) {
+      if (gameobject->ShouldDestroy) {
+         // children go with their parent
+         for (auto* child : gameobject->children()) {
+            child->ShouldDestroy = true;
+         }
+         anyDestroyed = true;
+      }
+   }
+   if (anyDestroyed) {
+      for (auto& layer : drawLayers) {
+         std::erase_if(layer, [](const GameObject* gameobject) { return gameobject->ShouldDestroy; });
+      }
+      for (auto& layer : unindexedLayers) {
+         std::erase_if(layer, [](const GameObject* gameobject) { return gameobject->ShouldDestroy; });
+      }
+      std::erase_if(World::gameobjects, [](const auto& gameobject) {
+         if (!gameobject->ShouldDestroy) {
+            return false;
+         }
+         if (gameobject->square) {
+            spatialIndex.Remove(gameobject->square);
+         }
+         entities.Remove(gameobject->handle);
+         return true;
+      });
+      entities.Compact();
+   }
 
    // add newly created objects
    // -------------------------
    for (auto& o : World::gameobjectstoadd)
-      World::gameobjects.push_back(std::move(o));
+      World::AddObject(std::move(o));
    World::gameobjectstoadd.clear();
 }
 
+bool World::Step() {
+   const int STEPS_PER_TICK = (int)(FixedClock::STEPS_PER_SECOND / TICKS_PER_SECOND);
+
+   Input::currentTime += Input::deltaTime;
+   if (!settingTimeSpeed) {
+      timeSpeed = zeno(timeSpeed, 1.0, 0.4);
+   } else {
+      settingTimeSpeed = false;
+   }
+
+   UpdateObjects();
+
+   if (ticksPaused()) {
+      return false;
+   }
+   if (shouldTick) {
+      shouldTick = false;
+   } else if (++stepsSinceTick < STEPS_PER_TICK) {
+      return false;
+   }
+   TickObjects();
+   stepsSinceTick = 0;
+   return true;
+}
+
 void World::TickObjects() {
-   auto objects = get_gameobjects();
-   sortGameObjectsByPriority(objects);
+   if (auto player = getFirst<Player>()) {
+      flowField.Build({player->tile_x, player->tile_y});
+   }
+   danger.Build();
+
+   ticking.clear();
+   for (auto& layer : drawLayers) {
+      for (auto* gameobject : layer) {
+         if (!IsFrozen(*gameobject)) {
+            ticking.push_back(gameobject);
+         }
+      }
+   }
+
+   // Everyone decides from the world as it was at the start of the tick and only writes their own members, so the
+   // outcome doesn't depend on the number of threads or the order they run in
+   if (!tickPool || (tickThreads != 0 && tickPool->Threads() != tickThreads)) {
+      tickPool = std::make_unique<TaskPool>(tickThreads);
+   }
+   tickPool->ParallelFor(ticking.size(), 64, [](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+         ticking[i]->decide();
+      }
+   });
 
-   for (auto& gameobject : objects) {
+   // Moves, attacks and spawns are then applied serially, in the same order on every run
+   for (auto* gameobject : ticking) {
       gameobject->tickUpdate();
    }
 }
 
+bool World::IsFrozen(const GameObject& gameobject) {
+   return gameobject.square && !streamer.IsSimulated(gameobject.square->tile_x, gameobject.square->tile_y);
+}
+
 void World::RenderObjects(Renderer& renderer) {
-   auto objects = get_gameobjects();
-   sortGameObjectsByPriority(objects);
+   // Objects are drawn at their smoothed position, which can lag a tile behind tile_x/tile_y, and some are drawn
+   // larger than a tile, so look a bit past the edges of the view
+   const int margin = 2;
+
+   auto [viewMin, viewMax] = renderer.ViewBounds();
+   int minX                = (int)std::floor(viewMin.x) - margin;
+   int minY                = (int)std::floor(viewMin.y) - margin;
+   int maxX                = (int)std::ceil(viewMax.x) + margin;
+   int maxY                = (int)std::ceil(viewMax.y) + margin;
 
-   for (auto& gameobject : objects) {
-      gameobject->render(renderer);
+   for (auto& layer : visibleLayers) {
+      layer.clear();
+   }
+   renderedObjects = 0;
+   for (int x = minX; x <= maxX; x++) {
+      for (int y = minY; y <= maxY; y++) {
+         for (auto* object : spatialIndex.At(x, y)) {
+            visibleLayers[(size_t)object->drawPriority].push_back(object);
+            renderedObjects++;
+         }
+      }
+   }
+   culledObjects = (uint32_t)spatialIndex.Size() - renderedObjects;
+
+   // tiles and sprites are batched per draw layer, so flush after each layer
+   for (size_t i = 0; i < drawLayers.size(); i++) {
+      if (unindexedLayers[i].empty() && visibleLayers[i].empty()) {
+         continue;
+      }
+      for (auto* gameobject : unindexedLayers[i]) {
+         gameobject->render(renderer);
+      }
+      for (auto* gameobject : visibleLayers[i]) {
+         gameobject->render(renderer);
+      }
+      renderer.FlushBatches();
    }
 }
 
@@ -129,3 +303,39 @@ bool World::ticksPaused() {
    auto player = getFirst<Player>();
    return player->pauseTicks();
 }
+
+uint64_t World::StateHash() {
+   // Fixed layout, so padding never ends up in the hash
+   struct ObjectState {
+      int32_t   tile_x        = 0;
+      int32_t   tile_y        = 0;
+      glm::vec2 position      = glm::vec2(0.0f);
+      int32_t   health        = 0;
+      int32_t   stunnedLength = 0;
+      uint32_t  wall          = 0;
+      uint32_t  shouldDestroy = 0;
+   };
+
+   uint64_t hash = 0;
+   for (auto& gameobject : gameobjects) {
+      // Fog, text and the background aren't part of the simulation
+      if (!gameobject->square) {
+         continue;
+      }
+      ObjectState state;
+      state.tile_x        = gameobject->square->tile_x;
+      state.tile_y        = gameobject->square->tile_y;
+      state.position      = gameobject->position;
+      state.shouldDestroy = gameobject->ShouldDestroy;
+      if (auto character = dynamic_cast<Character*>(gameobject.get())) {
+         state.health        = character->health;
+         state.stunnedLength = character->stunnedLength;
+      }
+      if (auto tile = dynamic_cast<Tile*>(gameobject.get())) {
+         state.wall = tile->wall;
+      }
+      hash = XXH64(gameobject->name.data(), gameobject->name.size(), hash);
+      hash = XXH64(&state, sizeof(state), hash);
+   }
+   return hash;
+}
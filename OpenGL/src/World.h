@@ -1,74 +1,165 @@
 // World.h
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
 #include <functional>
+#include <random>
 #include "game_objects/GameObject.h"
+#include "game_objects/SquareObject.h"
 #include "Renderer.h"
+#include "SpatialIndex.h"
+#include "EntityStore.h"
+#include "ChunkStreamer.h"
+#include "FlowField.h"
+#include "DangerField.h"
+#include "WallChangeLog.h"
+
+struct MapView;
 
 class World {
 public:
+   static constexpr float TICKS_PER_SECOND = 3.0f;
+
    static float                                    timeSpeed;
    static bool                                     settingTimeSpeed;
+   // When set, objects skip creating textures, shaders and GL buffers so the world can be simulated without a window
+   // or GL context (see SpaceBoomSim).
+   static bool                                     headless;
    static std::vector<std::shared_ptr<GameObject>> gameobjects;
    static std::vector<std::unique_ptr<GameObject>> gameobjectstoadd;
+   static SpatialIndex                             spatialIndex;
+   static EntityStore                              entities;
+   // Tiles whose wall was destroyed or streamed in or out since the map was loaded
+   static WallChangeLog                            wallChanges;
+   // Bumped by LoadMap; anything derived from the previous map's walls must be rebuilt
+   static uint32_t                                 mapVersion;
+   // Instance slots of Renderer::tiles given back by destroyed tiles, freed on the next flush
+   static std::vector<uint32_t>                    releasedTileSlots;
+   // Maps with more tiles than this are streamed in chunks around the player instead of spawned whole
+   static size_t                                   streamingThreshold;
+   static ChunkStreamer                            streamer;
+   // Distance to the player for enemy pathing, brought up to date at the start of every tick
+   static FlowField                                flowField;
+   // Tiles about to be hit by a blast or bullet, rebuilt at the start of every tick
+   static DangerField                              danger;
+   // Threads TickObjects runs the decide phase on, counting the calling thread; 0 means one per hardware thread
+   static unsigned                                 tickThreads;
+   // Every random choice the game makes comes from here, so a session can be replayed from its seed
+   static std::mt19937                             rng;
 
-   static bool ticksPaused();
+   // Every object and its children, bucketed by DrawPriority in the order they were added. Kept up to date by
+   // AddObject and the removal of destroyed objects, so update, tick and render walk these without sorting. An
+   // object's drawPriority and children() must not change after it has been added.
+   static std::array<std::vector<GameObject*>, (size_t)DrawPriority::UI + 1> drawLayers;
+   // The objects of drawLayers that aren't in the spatial index (everything but SquareObjects). RenderObjects always
+   // draws these; SquareObjects are instead looked up in the spatial index around the camera, so off-screen ones are
+   // never visited.
+   static std::array<std::vector<GameObject*>, (size_t)DrawPriority::UI + 1> unindexedLayers;
 
-   static std::vector<GameObject*>                 get_gameobjects() {
-      // return a vector of all gameobjects and their gameobjects.children
-      std::vector<GameObject*> allGameObjects;
-      for (auto& gameobject : gameobjects) {
-         allGameObjects.push_back(gameobject.get());
-         auto children = gameobject->children();
-         allGameObjects.insert(allGameObjects.end(), children.begin(), children.end());
-      }
-      return allGameObjects;
-   }
+   // Render stats of the last frame: SquareObjects drawn, and ones skipped for being off-screen
+   static uint32_t renderedObjects;
+   static uint32_t culledObjects;
 
+   static bool ticksPaused();
+
+   // Queries by type only visit the kinds of object that are a T, one dynamic_cast per kind rather than per object.
+   // Results come in the order the objects were added, as if walking gameobjects.
    template <typename T>
-   static std::vector<std::shared_ptr<T>> where(std::function<bool(const T&)> condition) {
-      std::vector<std::shared_ptr<T>> filteredObjects;
-      for (auto& gameobject : gameobjects) {
-         std::shared_ptr<T> castedObject = std::dynamic_pointer_cast<T>(gameobject);
-         if (castedObject && condition(*castedObject)) {
-            filteredObjects.push_back(castedObject);
+   static std::vector<T*> where(std::function<bool(const T&)> condition) {
+      std::vector<T*> filteredObjects;
+      int             matchingKinds = 0;
+      for (auto& [kind, objects] : entities.Kinds()) {
+         if (objects.empty() || !dynamic_cast<T*>(objects.front())) {
+            continue;
+         }
+         matchingKinds++;
+         for (auto* object : objects) {
+            T* castedObject = static_cast<T*>(object);
+            if (condition(*castedObject)) {
+               filteredObjects.push_back(castedObject);
+            }
          }
       }
+      if (matchingKinds > 1) {
+         std::sort(filteredObjects.begin(), filteredObjects.end(),
+                   [](const T* a, const T* b) { return entities.Sequence(a) < entities.Sequence(b); });
+      }
       return filteredObjects;
    }
 
    template <typename T>
    static std::vector<T*> getAll() {
-      std::vector<T*> allObjects;
-      for (auto& gameobject : gameobjects) {
-         T* castedObject = dynamic_cast<T*>(gameobject.get());
-         if (castedObject) {
-            allObjects.push_back(castedObject);
+      return where<T>([](const T&) { return true; });
+   }
+
+   // The earliest added object that is a T
+   template <typename T>
+   static T* getFirst() {
+      T* first = nullptr;
+      for (auto& [kind, objects] : entities.Kinds()) {
+         if (!objects.empty()) {
+            T* castedObject = dynamic_cast<T*>(objects.front());
+            if (castedObject && (!first || entities.Sequence(castedObject) < entities.Sequence(first))) {
+               first = castedObject;
+            }
          }
       }
-      return allObjects;
+      return first;
    }
 
+   // The object a handle refers to, or nullptr if it has been removed since or isn't a T
    template <typename T>
-   static T* getFirst() {
-      for (auto& gameobject : gameobjects) {
-         T* castedObject = dynamic_cast<T*>(gameobject.get());
-         if (castedObject) {
-            return castedObject;
+   static T* resolve(EntityHandle handle) {
+      return dynamic_cast<T*>(entities.Get(handle));
+   }
+
+   template <typename T>
+   static std::vector<T*> at(int x, int y) {
+      std::vector<T*> found;
+      for (auto* object : spatialIndex.At(x, y)) {
+         if (T* castedObject = dynamic_cast<T*>(object)) {
+            found.push_back(castedObject);
          }
       }
-      return nullptr;
+      return found;
    }
 
+   // All objects of type T whose manhattan distance to (x, y) is less than radius. Only the tiles inside the radius are
+   // visited, so this is cheap regardless of how many objects are in the world.
    template <typename T>
-   static std::vector<std::shared_ptr<T>> at(int x, int y) {
-      return where<T>([&](const T& obj) { return obj.tile_x == x && obj.tile_y == y; });
+   static std::vector<T*> nearby(int x, int y, int radius) {
+      std::vector<T*> found;
+      for (int dx = -radius + 1; dx < radius; ++dx) {
+         int reach = radius - 1 - std::abs(dx);
+         for (int dy = -reach; dy <= reach; ++dy) {
+            for (auto* object : spatialIndex.At(x + dx, y + dy)) {
+               if (T* castedObject = dynamic_cast<T*>(object)) {
+                  found.push_back(castedObject);
+               }
+            }
+         }
+      }
+      return found;
    }
 
+   static void AddObject(std::shared_ptr<GameObject> object);
+   // Loads an ASCII map (*.txt) or a binary one (*.sbm, see MapFile.h), relative to the res directory unless the
+   // path is absolute
    static void LoadMap(const std::string& map_path);
+   // Creates the tiles, then the spawns in table order. The tiles of maps above streamingThreshold go to the streamer.
+   static void SpawnMap(const MapView& map);
 
+   // One fixed step (FixedClock::STEP) with the input currently in Input: updates every object, and ticks every
+   // 1 / TICKS_PER_SECOND seconds or as soon as the player asks for it. Returns whether this step ticked.
+   static bool Step();
    static void UpdateObjects();
    static void TickObjects();
+   // SquareObjects outside the chunks the streamer simulates are neither updated nor ticked
+   static bool IsFrozen(const GameObject& gameobject);
    static void RenderObjects(Renderer& renderer);
+   // Hash of the simulation state of every object on the map; a replay has to end with the same one as the recording
+   static uint64_t StateHash();
    static bool shouldTick;
 };
@@ -0,0 +1,283 @@
+// Micro-benchmark of the per-frame fog geometry. Runs every stage of Fog's pipeline separately on the shipped maps and
+// on generated large maps, from many player positions, and prints the timings as JSON so runs can be compared between
+// commits. Headless: never creates a window or GL context.
+//
+// usage: SpaceBoomBench [options]
+//    --positions N   player positions sampled per map (default 64)
+//    --reference N   positions per map also run through the brute-force visibility polygon, whose output is compared
+//                    against the grid accelerated one (default 16, 0 to skip)
+//    --output FILE   write the JSON to FILE instead of stdout
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MapGenerator.h"
+#include "World.h"
+#include "clipper2/clipper.h"
+#include "earcut.hpp"
+#include "game_objects/GeometryUtils.h"
+#include "game_objects/Tile.h"
+
+using namespace Clipper2Lib;
+using namespace GeometryUtils;
+
+namespace {
+
+struct Scene {
+   std::string                         name;
+   int                                 width  = 0;
+   int                                 height = 0;
+   std::vector<std::vector<glm::vec2>> walls;  // tile bounds, as Fog collects them
+   std::vector<glm::vec2>              floors; // candidate player positions
+};
+
+// Samples of one stage, in microseconds
+class Timings {
+public:
+   template <typename F>
+   auto measure(F&& f) {
+      auto start  = std::chrono::steady_clock::now();
+      auto result = f();
+      auto end    = std::chrono::steady_clock::now();
+      samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+      return result;
+   }
+
+   void writeJson(std::ostream& out) const {
+      std::vector<double> sorted = samples;
+      std::sort(sorted.begin(), sorted.end());
+
+      double total = 0;
+      for (double sample : sorted) {
+         total += sample;
+      }
+      auto percentile = [&](double p) {
+         return sorted.empty() ? 0.0 : sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+      };
+
+      out << "{\"samples\": " << sorted.size() << ", \"mean_us\": " << (sorted.empty() ? 0.0 : total / sorted.size())
+          << ", \"median_us\": " << percentile(0.5) << ", \"p95_us\": " << percentile(0.95)
+          << ", \"min_us\": " << percentile(0.0) << ", \"max_us\": " << percentile(1.0) << "}";
+   }
+
+private:
+   std::vector<double> samples;
+};
+
+Scene loadShippedMap(const std::string& name) {
+   World::LoadMap("maps/" + name + ".txt");
+
+   Scene scene;
+   scene.name = name;
+   for (auto tile : World::getAll<Tile>()) {
+      scene.width  = std::max(scene.width, tile->tile_x + 1);
+      scene.height = std::max(scene.height, tile->tile_y + 1);
+      if (tile->wall) {
+         scene.walls.push_back(tile->getBounds());
+      } else {
+         scene.floors.push_back(tile->position);
+      }
+   }
+   return scene;
+}
+
+// Seeded station layout from MapGenerator, so every run benchmarks the same map
+Scene generateMap(int size, unsigned seed) {
+   MapGeneratorOptions options;
+   options.width  = size;
+   options.height = size;
+   options.seed   = seed;
+   MapData map    = MapGenerator::Generate(options);
+   MapView view   = map.view();
+
+   Scene scene;
+   scene.name   = "generated-" + std::to_string(size);
+   scene.width  = size;
+   scene.height = size;
+   for (uint32_t y = 0; y < view.header.height; y++) {
+      for (uint32_t x = 0; x < view.header.width; x++) {
+         TileKind kind = view.at(x, y);
+         if (kind == TileKind::Empty) {
+            continue;
+         }
+         Tile tile("Tile", kind != TileKind::Floor, false, (float)x, (float)y);
+         if (tile.wall) {
+            scene.walls.push_back(tile.getBounds());
+         } else {
+            scene.floors.push_back(tile.position);
+         }
+      }
+   }
+   return scene;
+}
+
+size_t triangulate(const PolyTreeD& polytree) {
+   size_t indices = 0;
+   for (auto& region : polytree) {
+      std::vector<std::vector<PointD>> polygon = {region->Polygon()};
+      for (auto& hole : *region) {
+         polygon.push_back(hole->Polygon());
+         indices += triangulate(*hole);
+      }
+      indices += mapbox::earcut<uint32_t>(polygon).size();
+   }
+   return indices;
+}
+
+// Writes the scene's results as a JSON object and returns how many positions disagreed with the reference
+int benchmarkScene(const Scene& scene, int positions, int referencePositions, std::ostream& out) {
+   std::map<std::string, Timings> stages;
+
+   // The wall union only changes when walls do, but it is the first thing rebuilt on a new map, so time it too
+   const int unionRuns = 5;
+   PolyTreeD wallUnion;
+   for (int i = 0; i < unionRuns; i++) {
+      wallUnion.Clear();
+      stages["findPolygonUnion"].measure([&] { return findPolygonUnion(scene.walls, wallUnion); });
+   }
+   PathsD flattened;
+   for (int i = 0; i < unionRuns; i++) {
+      flattened = stages["FlattenPolyPathD"].measure([&] { return FlattenPolyPathD(wallUnion); });
+   }
+   PathsD hull;
+   for (auto& child : wallUnion) {
+      hull.push_back(child->Polygon());
+   }
+
+   size_t edges = 0;
+   for (auto& path : flattened) {
+      edges += path.size();
+   }
+
+   // Spread the player positions evenly over the floor tiles
+   std::vector<glm::vec2> samples;
+   if (!scene.floors.empty()) {
+      size_t step = std::max<size_t>(1, scene.floors.size() / std::max(1, positions));
+      for (size_t i = 0; i < scene.floors.size() && (int)samples.size() < positions; i += step) {
+         samples.push_back(scene.floors[i]);
+      }
+   }
+
+   int    referenceRuns = 0;
+   int    mismatches    = 0;
+   size_t fogIndices    = 0;
+   for (size_t i = 0; i < samples.size(); i++) {
+      const auto& position = samples[i];
+
+      auto visibility = stages["ComputeVisibilityPolygon"].measure(
+         [&] { return ComputeVisibilityPolygon(position, flattened); });
+
+      if (referenceRuns < referencePositions) {
+         auto reference = stages["ComputeVisibilityPolygonBruteForce"].measure(
+            [&] { return ComputeVisibilityPolygonBruteForce(position, flattened); });
+         referenceRuns++;
+         if (reference != visibility) {
+            mismatches++;
+            std::cerr << scene.name << ": visibility polygon differs from the brute-force one at (" << position.x
+                      << ", " << position.y << ")" << std::endl;
+         }
+      }
+
+      PolyTreeD fogPaths;
+      stages["ClipperDifference (fog)"].measure([&] {
+         ClipperD clipper;
+         clipper.AddSubject(hull);
+         clipper.AddClip({visibility});
+         clipper.AddClip({flattened});
+         return clipper.Execute(ClipType::Difference, FillRule::NonZero, fogPaths);
+      });
+
+      PolyTreeD tintPaths;
+      stages["ClipperDifference (tint)"].measure([&] {
+         ClipperD tint;
+         tint.AddSubject({flattened});
+         tint.AddClip({visibility});
+         return tint.Execute(ClipType::Difference, FillRule::NonZero, tintPaths);
+      });
+
+      fogIndices += stages["earcut"].measure([&] { return triangulate(fogPaths) + triangulate(tintPaths); });
+   }
+
+   out << "    {\n"
+       << "      \"map\": \"" << scene.name << "\",\n"
+       << "      \"size\": [" << scene.width << ", " << scene.height << "],\n"
+       << "      \"walls\": " << scene.walls.size() << ",\n"
+       << "      \"outline_vertices\": " << edges << ",\n"
+       << "      \"positions\": " << samples.size() << ",\n"
+       << "      \"reference_positions\": " << referenceRuns << ",\n"
+       << "      \"reference_mismatches\": " << mismatches << ",\n"
+       << "      \"fog_indices_per_frame\": " << (samples.empty() ? 0 : fogIndices / samples.size()) << ",\n"
+       << "      \"stages\": {";
+   bool first = true;
+   for (auto& [stage, timings] : stages) {
+      out << (first ? "\n" : ",\n") << "        \"" << stage << "\": ";
+      timings.writeJson(out);
+      first = false;
+   }
+   out << "\n      }\n"
+       << "    }";
+   return mismatches;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   int         positions          = 64;
+   int         referencePositions = 16;
+   std::string outputPath;
+
+   for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg == "--positions" && i + 1 < argc) {
+         positions = std::atoi(argv[++i]);
+      } else if (arg == "--reference" && i + 1 < argc) {
+         referencePositions = std::atoi(argv[++i]);
+      } else if (arg == "--output" && i + 1 < argc) {
+         outputPath = argv[++i];
+      } else {
+         std::cerr << "usage: SpaceBoomBench [--positions N] [--reference N] [--output FILE]" << std::endl;
+         return 1;
+      }
+   }
+
+   World::headless = true;
+
+   std::vector<Scene> scenes;
+   for (auto name : {"Facility", "Map", "SpaceShip"}) {
+      scenes.push_back(loadShippedMap(name));
+   }
+   scenes.push_back(generateMap(128, 1));
+   scenes.push_back(generateMap(256, 2));
+
+   std::ostringstream json;
+   json << "{\n"
+        << "  \"benchmark\": \"fog geometry\",\n"
+        << "  \"positions_per_map\": " << positions << ",\n"
+        << "  \"maps\": [\n";
+   int mismatches = 0;
+   for (size_t i = 0; i < scenes.size(); i++) {
+      std::cerr << "benchmarking " << scenes[i].name << "..." << std::endl;
+      mismatches += benchmarkScene(scenes[i], positions, referencePositions, json);
+      json << (i + 1 < scenes.size() ? ",\n" : "\n");
+   }
+   json << "  ]\n"
+        << "}\n";
+
+   if (outputPath.empty()) {
+      std::cout << json.str();
+   } else {
+      std::ofstream file(outputPath);
+      file << json.str();
+   }
+
+   // Fail the run if the accelerated visibility polygon ever disagrees with the reference
+   return mismatches == 0 ? 0 : 2;
+}
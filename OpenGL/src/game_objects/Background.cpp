@@ -1,8 +1,13 @@
 #include "Background.h"
+#include "../World.h"
 #include <array>
 
 Background::Background(const std::string& name)
    : GameObject(name, DrawPriority::Background, {0, 0}) {
+   if (World::headless) {
+      return;
+   }
+
    shader = Shader::create(Renderer::ResPath() + "shaders/stars.shader");
 
    std::array<float, 8> positions = {-1.0f, -1.0f, 1.0f, -1.0f, 1.0f, 1.0f, -1.0f, 1.0f};
@@ -16,12 +21,6 @@ Background::Background(const std::string& name)
    ib = std::make_shared<IndexBuffer>(IndexBuffer(indices));
 }
 
-void Background::setUpShader(Renderer& renderer) {
-   GameObject::setUpShader(renderer);
-   auto [width, height] = renderer.WindowSize();
-   shader->SetUniform2f("u_Resolution", {(float)width, (float)height});
-}
-
 void Background::render(Renderer& renderer) {
    GameObject::render(renderer);
 
@@ -6,5 +6,4 @@ public:
    Background(const std::string& name);
    virtual void render(Renderer& renderer) override;
    virtual void update() override;
-   virtual void setUpShader(Renderer& renderer) override;
 };
@@ -11,7 +11,7 @@ Bomb::Bomb(const std::string& name, float x, float y)
 void Bomb::tickUpdate() {
    tintColor.a = zeno(tintColor.a, 0.0, 0.5);
    // Explode the bomb
-   if (ExplodeTick > 6) {
+   if (ExplodeTick > FUSE_TICKS) {
       explode();
    } else {
       ExplodeTick++;
@@ -19,16 +19,13 @@ void Bomb::tickUpdate() {
 }
 
 void Bomb::explode() {
-   auto nearbyWalls = World::where<Tile>(
-      [&](const Tile& tile) { return (std::abs(tile_x - tile.tile_x) + std::abs(tile_y - tile.tile_y) < 3); });
+   auto nearbyWalls = World::nearby<Tile>(tile_x, tile_y, BLAST_RADIUS);
 
    for (auto wall : nearbyWalls) {
       wall->explode();
    }
 
-   auto nearbyCharacters = World::where<Character>([&](const Character& character) {
-      return (std::abs(tile_x - character.tile_x) + std::abs(tile_y - character.tile_y) < 3);
-   });
+   auto nearbyCharacters = World::nearby<Character>(tile_x, tile_y, BLAST_RADIUS);
    for (auto character : nearbyCharacters) {
       character->hurt();
       std::cout << "bomb damaged " << character->name << ". their health is now " << character->health << std::endl;
@@ -3,6 +3,10 @@
 
 class Bomb : public Entity {
 public:
+   // Ticks a bomb waits before exploding, and the (manhattan) distance its blast stays below
+   static constexpr int FUSE_TICKS   = 6;
+   static constexpr int BLAST_RADIUS = 3;
+
    Bomb(const std::string& name, float x, float y);
    virtual void tickUpdate() override;
    virtual void kick(bool hitWall, int dx, int dy) override;
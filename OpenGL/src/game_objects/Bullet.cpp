@@ -29,6 +29,5 @@ void Bullet::tickUpdate() {
    }
 
    // Move the bullet
-   tile_x += direction_x;
-   tile_y += direction_y;
+   setTile(tile_x + direction_x, tile_y + direction_y);
 }
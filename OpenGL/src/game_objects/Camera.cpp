@@ -1,4 +1,5 @@
 #include "Camera.h"
 
-glm::vec2 Camera::position = {0.0, 0.0};
-float     Camera::scale    = 14.0f;
+glm::vec2 Camera::position         = {0.0, 0.0};
+glm::vec2 Camera::previousPosition = {0.0, 0.0};
+float     Camera::scale            = 14.0f;
@@ -4,5 +4,7 @@
 class Camera {
 public:
    static glm::vec2 position;
-   static float scale;
+   // position before the latest simulation step; frames are drawn from somewhere in between
+   static glm::vec2 previousPosition;
+   static float     scale;
 };
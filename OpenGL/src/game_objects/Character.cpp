@@ -31,8 +31,8 @@ bool Character::move(int new_x, int new_y) {
          int check_x = tile_x + (dx * i) / steps;
          int check_y = tile_y + (dy * i) / steps;
 
-         bool                    spot_occupied   = false;
-         std::shared_ptr<Entity> other_character = nullptr;
+         bool    spot_occupied   = false;
+         Entity* other_character = nullptr;
 
          // Check for walls
          for (auto& tile : World::at<Tile>(check_x, check_y)) {
@@ -45,7 +45,7 @@ bool Character::move(int new_x, int new_y) {
          if (!spot_occupied) {
             // Check for other characters
             for (auto& entity : World::at<Entity>(check_x, check_y)) {
-               if (entity.get() != this) {
+               if (entity != this) {
                   spot_occupied   = true;
                   other_character = entity;
                   break;
@@ -78,7 +78,7 @@ bool Character::move(int new_x, int new_y) {
                   }
                   if (!obstacle) {
                      for (auto& character : World::at<Character>(new_enemy_x, new_enemy_y)) {
-                        if (character != other_character && character.get() != this) {
+                        if (character != other_character && character != this) {
                            obstacle = true;
                            break;
                         }
@@ -93,14 +93,13 @@ bool Character::move(int new_x, int new_y) {
                // Move enemy back as far as possible
                if (knockback_distance > 0) {
                   KickState kicking;
-                  kicking.victim    = other_character;
+                  kicking.victim    = other_character->handle;
                   kicking.direction = glm::ivec2(knockback_dx * knockback_distance, knockback_dy * knockback_distance);
                   kicking.intoWall  = knockback_distance < max_knockback_distance;
                   this->kicking     = kicking;
 
                   // Stop the player at the collision spot
-                  tile_x = check_x;
-                  tile_y = check_y;
+                  setTile(check_x, check_y);
 
                   return true; // Move succeeded with kick
                } else {
@@ -114,16 +113,14 @@ bool Character::move(int new_x, int new_y) {
                bunnyHopCoolDown = 0;
             }
             if (i > 1) {
-               tile_x = tile_x + (dx * (i - 1)) / steps;
-               tile_y = tile_y + (dy * (i - 1)) / steps;
+               setTile(tile_x + (dx * (i - 1)) / steps, tile_y + (dy * (i - 1)) / steps);
             }
             return false;
          }
       }
 
       // Path is clear; move the character
-      tile_x = new_x;
-      tile_y = new_y;
+      setTile(new_x, new_y);
       return true;
    } else if (stunnedLength > 0) {
       stunnedLength--;
@@ -4,9 +4,9 @@
 #include "Tile.h"
 
 struct KickState {
-   std::weak_ptr<Entity> victim;
-   glm::ivec2            direction;
-   bool                  intoWall;
+   EntityHandle victim;
+   glm::ivec2   direction;
+   bool         intoWall;
 };
 
 class Character : public Entity {
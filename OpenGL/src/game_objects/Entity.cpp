@@ -9,6 +9,5 @@ Entity::Entity(const std::string& name, DrawPriority drawPriority, int tile_x, i
 
 void Entity::kick(bool hitWall, int dx, int dy) {
    audio().Impact.play();
-   tile_x += dx;
-   tile_y += dy;
+   setTile(tile_x + dx, tile_y + dy);
 }
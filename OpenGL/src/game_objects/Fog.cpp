@@ -1,6 +1,7 @@
 #include "Fog.h"
 #include "Tile.h"
 #include "Player.h"
+#include <set>
 #include <vector>
 #include "clipper2/clipper.h"
 #include "GeometryUtils.h"
@@ -10,44 +11,113 @@ using namespace Clipper2Lib;
 using namespace GeometryUtils;
 
 Fog::Fog()
-   : GameObject("Fog of War", DrawPriority::Fog, {0, 0}) {
+   : GameObject("Fog of War", DrawPriority::Fog, {0, 0})
+   , wallChanges(World::wallChanges.AddReader()) {
    shader       = Shader::create(Renderer::ResPath() + "shaders/fog.shader");
    mainFogColor = {0.1, 0.1, 0.1, 1};
    tintFogColor = {0.1, 0.1, 0.1, 0};
+
+   fogVb = std::make_shared<VertexBuffer>(4096 * sizeof(FogVertex), GL_STREAM_DRAW);
+   VertexBufferLayout layout;
+   layout.Push<float>(2); // position
+   layout.Push<float>(4); // color
+   layout.Push<float>(4); // band color
+   fogVa = std::make_shared<VertexArray>(fogVb, layout);
+   fogIb = std::make_shared<IndexBuffer>(8192, GL_STREAM_DRAW);
+}
+
+Fog::~Fog() {
+   World::wallChanges.RemoveReader(wallChanges);
+}
+
+namespace {
+
+int floorDiv(int value, int divisor) {
+   return value / divisor - (value % divisor < 0 ? 1 : 0);
+}
+
+} // namespace
+
+void Fog::rebuildWallChunk(std::pair<int, int> chunk) {
+   std::vector<std::vector<glm::vec2>> bounds;
+   for (int x = chunk.first * WALL_CHUNK_SIZE; x < (chunk.first + 1) * WALL_CHUNK_SIZE; x++) {
+      for (int y = chunk.second * WALL_CHUNK_SIZE; y < (chunk.second + 1) * WALL_CHUNK_SIZE; y++) {
+         for (auto tile : World::at<Tile>(x, y)) {
+            bounds.push_back(tile->getBounds());
+         }
+      }
+   }
+
+   PolyTreeD chunkUnion;
+   findPolygonUnion(bounds, chunkUnion);
+   wallChunks[chunk] = FlattenPolyPathD(chunkUnion);
 }
 
-void Fog::setUpShader(Renderer& renderer) {
-   GameObject::setUpShader(renderer);
+void Fog::updateWallGeometry() {
+   bool changed = false;
+
+   if (wallsMapVersion != World::mapVersion) {
+      // New map: every chunk that has tiles needs its outline
+      wallChunks.clear();
+      std::set<std::pair<int, int>> chunks;
+      for (auto tile : World::getAll<Tile>()) {
+         chunks.insert({floorDiv(tile->tile_x, WALL_CHUNK_SIZE), floorDiv(tile->tile_y, WALL_CHUNK_SIZE)});
+      }
+      for (auto& chunk : chunks) {
+         rebuildWallChunk(chunk);
+      }
+      World::wallChanges.Read(wallChanges);
+      wallsMapVersion = World::mapVersion;
+      changed         = true;
+   } else if (World::wallChanges.HasUnread(wallChanges)) {
+      std::set<std::pair<int, int>> dirty;
+      for (const auto& tile : World::wallChanges.Read(wallChanges)) {
+         dirty.insert({floorDiv(tile.x, WALL_CHUNK_SIZE), floorDiv(tile.y, WALL_CHUNK_SIZE)});
+      }
+      for (auto& chunk : dirty) {
+         rebuildWallChunk(chunk);
+      }
+      changed = true;
+   }
+
+   if (!changed) {
+      return;
+   }
+
+   // Stitch the chunk outlines back together so walls crossing chunk borders don't get seams
+   PathsD chunkOutlines;
+   for (auto& [chunk, outline] : wallChunks) {
+      for (auto& path : outline) {
+         if (!path.empty()) {
+            chunkOutlines.push_back(path);
+         }
+      }
+   }
+   PolyTreeD combined;
+   findPolygonUnion(chunkOutlines, combined);
+   wallOutlines = FlattenPolyPathD(combined);
+
+   wallHull.clear();
+   for (auto& child : combined) {
+      wallHull.push_back(child->Polygon());
+   }
 }
 
 void Fog::render(Renderer& renderer) {
-   
+
    GameObject::render(renderer);
    bool showWalls = true;
 
-   // Collect all tile bounds
-   std::vector<std::vector<glm::vec2>> allBounds;
-   auto                                tiles = World::getAll<Tile>(); // Simplified retrieval of all tiles
-   for (auto tile : tiles) {
-      allBounds.push_back(tile->getBounds());
-   }
+   updateWallGeometry();
 
    // Get the player
    auto player = World::getFirst<Player>(); // Simplified retrieval of the first player
-   shader->SetUniform2f("uPlayerPosition", player->position);
 
-   // Compute the union of all tile bounds
-   PolyTreeD combined;
-   findPolygonUnion(allBounds, combined);
-   auto flattened = FlattenPolyPathD(combined);
+   const auto& flattened = wallOutlines;
 
    // Prepare the hull for clipping
    ClipperD clipper;
-   PathsD   hullPaths;
-   for (auto& child : combined) {
-      hullPaths.push_back(child->Polygon());
-   }
-   clipper.AddSubject(hullPaths);
+   clipper.AddSubject(wallHull);
 
    // Compute the visibility polygon
    auto visibility = ComputeVisibilityPolygon(player->position, flattened);
@@ -61,8 +131,11 @@ void Fog::render(Renderer& renderer) {
    PolyTreeD invisibilityPaths;
    clipper.Execute(ClipType::Difference, FillRule::NonZero, invisibilityPaths);
 
+   fogVertices.clear();
+   fogIndices.clear();
+
    // Render the invisibility regions
-   renderPolyTree(renderer, invisibilityPaths, mainFogColor, mainFogColor);
+   triangulatePolyTree(invisibilityPaths, mainFogColor, mainFogColor);
 
    if (showWalls) {
       // Tint all the walls that are not visible
@@ -72,44 +145,39 @@ void Fog::render(Renderer& renderer) {
       PolyTreeD tintPaths;
       tint.Execute(ClipType::Difference, FillRule::NonZero, tintPaths);
 
-      renderPolyTree(renderer, tintPaths, mainFogColor, tintFogColor);
+      triangulatePolyTree(tintPaths, mainFogColor, tintFogColor);
+   }
+
+   if (!fogIndices.empty()) {
+      fogVb->SetData(fogVertices);
+      fogIb->SetData(fogIndices);
+      renderer.Draw(*fogVa, *fogIb, *shader);
    }
 }
 
 void Fog::update() {}
 
-void Fog::renderPolyTree(Renderer& renderer, const PolyTreeD& polytree, glm::vec4 color, glm::vec4 bandColor) const {
+void Fog::triangulatePolyTree(const PolyTreeD& polytree, glm::vec4 color, glm::vec4 bandColor) {
    for (auto& shadedRegion : polytree) {
       std::vector<PointD>              shaded       = shadedRegion->Polygon();
       std::vector<std::vector<PointD>> invisibility = {shaded};
       for (auto& holeRegion : *shadedRegion) {
          invisibility.push_back(holeRegion->Polygon());
-         renderPolyTree(renderer, *holeRegion, color, bandColor);
+         triangulatePolyTree(*holeRegion, color, bandColor);
       }
 
       // Triangulate the invisibility regions
       std::vector<uint32_t> indices = mapbox::earcut<uint32_t>(invisibility);
 
-      // Collect vertices
-      std::vector<glm::vec2> vertices;
+      // Append to the frame's geometry; earcut indexes the region's own vertices, so offset them
+      uint32_t base = (uint32_t)fogVertices.size();
       for (const auto& shape : invisibility) {
          for (const auto& point : shape) {
-            vertices.emplace_back(point.x, point.y);
+            fogVertices.push_back({glm::vec2(point.x, point.y), color, bandColor});
          }
       }
-
-      // Create buffers and draw
-      VertexBufferLayout layout;
-      layout.Push<float>(2);
-      auto vb = std::make_shared<VertexBuffer>(vertices);
-      auto va = std::make_shared<VertexArray>(vb, layout);
-      auto ib = std::make_shared<IndexBuffer>(indices);
-
-      shader->SetUniform4f("u_Color", color);
-      shader->SetUniform4f("u_BandColor", bandColor);
-
-      if (va && ib && shader) {
-         renderer.Draw(*va, *ib, *shader);
+      for (auto index : indices) {
+         fogIndices.push_back(base + index);
       }
    }
 }
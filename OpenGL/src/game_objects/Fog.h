@@ -1,4 +1,6 @@
 #pragma once
+#include <map>
+#include <utility>
 #include "../World.h"
 #include "GameObject.h"
 #include "clipper2/clipper.h"
@@ -6,14 +8,43 @@
 class Fog : public GameObject {
 public:
    Fog();
+   ~Fog();
+   Fog(const Fog&)            = delete;
+   Fog& operator=(const Fog&) = delete;
    virtual void render(Renderer& renderer) override;
    virtual void update() override;
-   virtual void setUpShader(Renderer& renderer) override;
 
    glm::vec4 mainFogColor;
    glm::vec4 tintFogColor;
 
 private:
-   virtual void renderPolyTree(Renderer& renderer, const Clipper2Lib::PolyTreeD& polytree, glm::vec4 color,
-                               glm::vec4 bandColor) const;
+   // Side length, in tiles, of the regions the wall union is cached in
+   static constexpr int WALL_CHUNK_SIZE = 16;
+
+   // Brings the cached wall geometry up to date with World::wallChanges. Only the chunks containing changed tiles are
+   // re-unioned; the per-chunk outlines are then merged into wallHull/wallOutlines.
+   void updateWallGeometry();
+   void rebuildWallChunk(std::pair<int, int> chunk);
+
+   std::map<std::pair<int, int>, Clipper2Lib::PathsD> wallChunks;
+   Clipper2Lib::PathsD                                 wallHull;     // outer boundaries of the wall union
+   Clipper2Lib::PathsD                                 wallOutlines; // every ring of the wall union, simplified
+   uint32_t                                            wallsMapVersion = 0;
+   WallChangeLog::Reader                               wallChanges;
+
+   struct FogVertex {
+      glm::vec2 position;
+      glm::vec4 color;
+      glm::vec4 bandColor;
+   };
+
+   // Triangulates the regions of a polytree and appends them to the frame's fog geometry
+   void triangulatePolyTree(const Clipper2Lib::PolyTreeD& polytree, glm::vec4 color, glm::vec4 bandColor);
+
+   // All fog triangles of a frame are streamed into these and drawn with a single call
+   std::vector<FogVertex>        fogVertices;
+   std::vector<uint32_t>         fogIndices;
+   std::shared_ptr<VertexBuffer> fogVb;
+   std::shared_ptr<VertexArray>  fogVa;
+   std::shared_ptr<IndexBuffer>  fogIb;
 };
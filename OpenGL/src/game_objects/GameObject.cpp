@@ -10,25 +10,30 @@
 GameObject::GameObject(const std::string& name, DrawPriority drawPriority, glm::vec2 position)
    : name(name)
    , drawPriority(drawPriority)
-   , position(position) {
+   , position(position)
+   , previousPosition(position) {
    // TODO: Add any additional initialization if needed
 }
 
 void GameObject::update() {}
 
+glm::vec2 GameObject::renderPosition(float interpolation) const {
+   return glm::mix(previousPosition, position, interpolation);
+}
+
+void GameObject::decide() {}
 void GameObject::tickUpdate() {}
 
 void GameObject::setUpShader(Renderer& renderer) {
    if (shader) {
       shader->Bind();
-      float currentTime = (float)glfwGetTime();
-      shader->SetUniform1f("u_Time", currentTime);
-      shader->SetUniform1f("u_StartTime", Input::startTime);
 
-      auto mvp = CalculateMVP(renderer.WindowSize(), position, rotation, scale);
+      // Time, resolution and the view-projection come from the FrameData block; only the model part is per object
+      glm::vec2 drawnAt = renderPosition(renderer.camera.interpolation);
+      auto      mvp     = renderer.camera.viewProjection * ModelMatrix(drawnAt, rotation, scale);
 
       // Pass MVP matrix to the shader
-      shader->SetUniformMat4f("u_MVP", mvp);
+      shader->SetUniformMat4f(shader->MVPLocation(), mvp);
    }
 }
 
@@ -14,6 +14,9 @@
 #include "../IndexBuffer.h"
 #include "../VertexArray.h"
 #include "../Shader.h"
+#include "../EntityStore.h"
+
+class SquareObject;
 
 enum class DrawPriority {
    Background,
@@ -39,8 +42,13 @@ public:
    virtual void setUpShader(Renderer& renderer);
    virtual void render(Renderer& renderer);
    virtual void update();
+   // A tick runs in two phases. decide() is called for every object in parallel, so it may only read the world and
+   // write this object's own members; tickUpdate() then acts on that, one object at a time in draw layer order.
+   virtual void decide();
    virtual void tickUpdate();
 
+   // Where to draw the object, `interpolation` (see CameraState) of the way from previousPosition to position
+   glm::vec2 renderPosition(float interpolation) const;
 
    std::shared_ptr<Shader>       shader;
    std::shared_ptr<VertexArray>  va;
@@ -48,8 +56,15 @@ public:
    std::shared_ptr<IndexBuffer>  ib;
 
    std::string  name;
+   // Assigned by World::AddObject; use World::resolve to get back from a handle to the object
+   EntityHandle handle;
+   // Set by World::AddObject for SquareObjects, which live in World::spatialIndex, so World can get at their tile
+   // without a cast
+   SquareObject* square = nullptr;
    DrawPriority drawPriority;
    glm::vec2    position;
+   // position before the latest simulation step, for drawing frames that fall between two steps
+   glm::vec2    previousPosition;
    float        rotation = 0;
    float        scale    = 1.0f;
 
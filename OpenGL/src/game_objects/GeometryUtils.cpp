@@ -4,6 +4,7 @@
 #include <limits>
 #include <cmath>
 #include <cstdlib>
+#include <utility>
 #include "earcut.hpp"
 
 #include "../Renderer.h"
@@ -30,6 +31,12 @@ bool findPolygonUnion(const std::vector<std::vector<glm::vec2>>& polygons, PolyT
    return clipper.Execute(ClipType::Union, FillRule::Positive, output);
 }
 
+bool findPolygonUnion(const PathsD& polygons, PolyTreeD& output) {
+   ClipperD clipper;
+   clipper.AddSubject(polygons);
+   return clipper.Execute(ClipType::Union, FillRule::Positive, output);
+}
+
 PathsD FlattenPolyPathD(const PolyPathD& polyPath) {
    PathsD paths;
 
@@ -191,6 +198,206 @@ bool isPointObstructed(const glm::vec2& position, const glm::vec2& point,
    return false;
 }
 
+bool isPointObstructed(const glm::vec2& position, const glm::vec2& point, const SegmentGrid& grid) {
+   auto intersection_opt = grid.ClosestSegmentHit(position, point);
+   if (intersection_opt) {
+      return length2(intersection_opt.value(), position) < length2(point, position);
+   }
+   return false;
+}
+
+SegmentGrid::SegmentGrid(std::vector<std::array<glm::vec2, 2>> segmentList)
+   : segments(std::move(segmentList)) {
+   if (segments.empty()) {
+      return;
+   }
+
+   glm::dvec2 lo(std::numeric_limits<double>::max(), std::numeric_limits<double>::max());
+   glm::dvec2 hi(std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest());
+   for (const auto& segment : segments) {
+      for (const auto& p : segment) {
+         lo.x = std::min(lo.x, (double)p.x);
+         lo.y = std::min(lo.y, (double)p.y);
+         hi.x = std::max(hi.x, (double)p.x);
+         hi.y = std::max(hi.y, (double)p.y);
+      }
+   }
+
+   // Aim for about one segment per cell
+   const double margin = 1e-3;
+   origin              = lo - glm::dvec2(margin, margin);
+   double width        = hi.x - lo.x + 2 * margin;
+   double height       = hi.y - lo.y + 2 * margin;
+   cellSize            = std::max(1.0, std::sqrt(width * height / segments.size()));
+   columns             = std::max(1, (int)std::ceil(width / cellSize));
+   rows                = std::max(1, (int)std::ceil(height / cellSize));
+
+   // Register every segment in every cell its (slightly grown) bounding box touches. Growing the box makes sure a hit
+   // exactly on a cell border is found from either side.
+   auto cellRange = [&](const std::array<glm::vec2, 2>& segment, int& x0, int& y0, int& x1, int& y1) {
+      x0 = std::clamp((int)std::floor((std::min(segment[0].x, segment[1].x) - margin - origin.x) / cellSize), 0,
+                      columns - 1);
+      x1 = std::clamp((int)std::floor((std::max(segment[0].x, segment[1].x) + margin - origin.x) / cellSize), 0,
+                      columns - 1);
+      y0 = std::clamp((int)std::floor((std::min(segment[0].y, segment[1].y) - margin - origin.y) / cellSize), 0,
+                      rows - 1);
+      y1 = std::clamp((int)std::floor((std::max(segment[0].y, segment[1].y) + margin - origin.y) / cellSize), 0,
+                      rows - 1);
+   };
+
+   std::vector<uint32_t> counts((size_t)columns * rows, 0);
+   for (const auto& segment : segments) {
+      int x0, y0, x1, y1;
+      cellRange(segment, x0, y0, x1, y1);
+      for (int y = y0; y <= y1; y++) {
+         for (int x = x0; x <= x1; x++) {
+            counts[(size_t)y * columns + x]++;
+         }
+      }
+   }
+
+   cellStart.resize(counts.size() + 1, 0);
+   for (size_t i = 0; i < counts.size(); i++) {
+      cellStart[i + 1] = cellStart[i] + counts[i];
+   }
+   cellSegments.resize(cellStart.back());
+
+   // Filled in input order, so each cell lists its segments by ascending index
+   std::vector<uint32_t> fill(cellStart.begin(), cellStart.end() - 1);
+   for (uint32_t i = 0; i < segments.size(); i++) {
+      int x0, y0, x1, y1;
+      cellRange(segments[i], x0, y0, x1, y1);
+      for (int y = y0; y <= y1; y++) {
+         for (int x = x0; x <= x1; x++) {
+            cellSegments[fill[(size_t)y * columns + x]++] = i;
+         }
+      }
+   }
+
+   visitedStamp.resize(segments.size(), 0);
+}
+
+template <typename Intersect>
+std::optional<glm::vec2> SegmentGrid::closestHit(const glm::vec2& start, double dx, double dy, double tEnd,
+                                                 Intersect&& intersect) const {
+   if (segments.empty() || (dx == 0.0 && dy == 0.0)) {
+      return std::nullopt;
+   }
+
+   // Clip the line (start + t * d, 0 <= t <= tEnd) against the grid bounds
+   double tMin = 0.0;
+   double tMax = tEnd;
+   double d[2] = {dx, dy};
+   double s[2] = {start.x, start.y};
+   double lo[2] = {origin.x, origin.y};
+   double hi[2] = {origin.x + columns * cellSize, origin.y + rows * cellSize};
+   for (int axis = 0; axis < 2; axis++) {
+      if (d[axis] == 0.0) {
+         if (s[axis] < lo[axis] || s[axis] > hi[axis]) {
+            return std::nullopt;
+         }
+      } else {
+         double t0 = (lo[axis] - s[axis]) / d[axis];
+         double t1 = (hi[axis] - s[axis]) / d[axis];
+         if (t0 > t1) {
+            std::swap(t0, t1);
+         }
+         tMin = std::max(tMin, t0);
+         tMax = std::min(tMax, t1);
+      }
+   }
+   if (tMin > tMax) {
+      return std::nullopt;
+   }
+
+   // Walk the cells along the line front to back (Amanatides & Woo)
+   double entryX = s[0] + d[0] * tMin;
+   double entryY = s[1] + d[1] * tMin;
+   int    cx     = std::clamp((int)std::floor((entryX - origin.x) / cellSize), 0, columns - 1);
+   int    cy     = std::clamp((int)std::floor((entryY - origin.y) / cellSize), 0, rows - 1);
+   int    stepX  = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+   int    stepY  = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+
+   const double infinity = std::numeric_limits<double>::infinity();
+   double       tMaxX    = stepX > 0   ? (origin.x + (cx + 1) * cellSize - s[0]) / dx
+                           : stepX < 0 ? (origin.x + cx * cellSize - s[0]) / dx
+                                       : infinity;
+   double       tMaxY    = stepY > 0   ? (origin.y + (cy + 1) * cellSize - s[1]) / dy
+                           : stepY < 0 ? (origin.y + cy * cellSize - s[1]) / dy
+                                       : infinity;
+   double       tDeltaX  = stepX != 0 ? cellSize / std::fabs(dx) : infinity;
+   double       tDeltaY  = stepY != 0 ? cellSize / std::fabs(dy) : infinity;
+   double       length   = std::sqrt(dx * dx + dy * dy);
+
+   if (++currentStamp == 0) {
+      std::fill(visitedStamp.begin(), visitedStamp.end(), 0);
+      currentStamp = 1;
+   }
+
+   float                    closest_distance = std::numeric_limits<float>::max();
+   uint32_t                 closest_index    = 0;
+   std::optional<glm::vec2> closest_intersection;
+
+   while (true) {
+      size_t cell = (size_t)cy * columns + cx;
+      for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+         uint32_t index = cellSegments[i];
+         if (visitedStamp[index] == currentStamp) {
+            continue;
+         }
+         visitedStamp[index] = currentStamp;
+
+         const auto& line             = segments[index];
+         auto        intersection_opt = intersect(line[0], line[1]);
+         if (intersection_opt) {
+            auto current_distance = length2(*intersection_opt, start);
+            if (current_distance > 0.01) {
+               // ties go to the earlier segment, like a linear scan would
+               if (current_distance < closest_distance ||
+                   (current_distance == closest_distance && index < closest_index)) {
+                  closest_distance     = current_distance;
+                  closest_index        = index;
+                  closest_intersection = intersection_opt;
+               }
+            }
+         }
+      }
+
+      double tNext = std::min(tMaxX, tMaxY);
+      if (tNext > tMax) {
+         break;
+      }
+      // Anything in the remaining cells is at least tNext away; keep going a little past the current best so hits
+      // that are equally close (up to float rounding) still get compared
+      if (closest_intersection && tNext * length > std::sqrt((double)closest_distance) + 1e-3) {
+         break;
+      }
+
+      if (tMaxX < tMaxY) {
+         cx += stepX;
+         tMaxX += tDeltaX;
+      } else {
+         cy += stepY;
+         tMaxY += tDeltaY;
+      }
+      if (cx < 0 || cx >= columns || cy < 0 || cy >= rows) {
+         break;
+      }
+   }
+
+   return closest_intersection;
+}
+
+std::optional<glm::vec2> SegmentGrid::ClosestSegmentHit(const glm::vec2& start, const glm::vec2& end) const {
+   return closestHit(start, (double)end.x - start.x, (double)end.y - start.y, 1.0,
+                     [&](const glm::vec2& a, const glm::vec2& b) { return LineSegmentIntersect(start, end, a, b); });
+}
+
+std::optional<glm::vec2> SegmentGrid::ClosestRayHit(const glm::vec2& origin, double dx, double dy) const {
+   return closestHit(origin, dx, dy, std::numeric_limits<double>::infinity(),
+                     [&](const glm::vec2& a, const glm::vec2& b) { return RaySegmentIntersect(origin, dx, dy, a, b); });
+}
+
 bool adjacentInVectorCircular(size_t a, size_t b, size_t size) {
    return a == b || abs(static_cast<int>(a) - static_cast<int>(b)) == 1 || (a == 0 && b == size - 1);
 }
@@ -209,7 +416,8 @@ Side pointSide(const glm::vec2& point, const glm::vec2& linePoint, const glm::ve
    }
 }
 
-PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacles) {
+// useGrid picks between the SegmentGrid and testing every obstruction line; both give the same polygon
+PathD computeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacles, bool useGrid) {
    bool cull_frontfaces = false;
 
    enum class PointType { Start, End, Middle };
@@ -271,6 +479,17 @@ PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacle
       all_points.insert(all_points.end(), tagged_points.begin(), tagged_points.end());
    }
 
+   std::optional<SegmentGrid> grid;
+   if (useGrid) {
+      grid.emplace(obstructionLines);
+   }
+   auto obstructed = [&](const glm::vec2& point) {
+      return grid ? isPointObstructed(position, point, *grid) : isPointObstructed(position, point, obstructionLines);
+   };
+   auto rayHit = [&](const glm::vec2& origin, double dx, double dy) {
+      return grid ? grid->ClosestRayHit(origin, dx, dy) : RayIntersect(origin, dx, dy, obstructionLines);
+   };
+
    // Sort all points globally by angle
    std::sort(all_points.begin(), all_points.end(),
              [](const TaggedPoint& a, const TaggedPoint& b) { return a.angle < b.angle; });
@@ -289,7 +508,7 @@ PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacle
          }
       }
 
-      if (!isPointObstructed(position, {point.point.x, point.point.y}, obstructionLines)) {
+      if (!obstructed({point.point.x, point.point.y})) {
          filtered_points.push_back(pointCopy);
       }
    }
@@ -306,7 +525,7 @@ PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacle
       std::optional<glm::vec2> extendedPoint;
       if (point.end != PointType::Middle) {
          glm::vec2 direction = glm::normalize(vertex - position);
-         extendedPoint       = RayIntersect(vertex, direction.x, direction.y, obstructionLines);
+         extendedPoint       = rayHit(vertex, direction.x, direction.y);
          if (extendedPoint && length2(*extendedPoint, vertex) < 0.1) {
             std::cout << "vertex super close to extended: " << length2(*extendedPoint, vertex) << std::endl;
          }
@@ -335,4 +554,12 @@ PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacle
    return path;
 }
 
+PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacles) {
+   return computeVisibilityPolygon(position, obstacles, true);
+}
+
+PathD ComputeVisibilityPolygonBruteForce(const glm::vec2& position, const PathsD& obstacles) {
+   return computeVisibilityPolygon(position, obstacles, false);
+}
+
 } // namespace GeometryUtils
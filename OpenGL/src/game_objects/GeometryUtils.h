@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <functional>
 #include <optional>
@@ -19,6 +20,17 @@ using namespace Clipper2Lib;
  */
 bool findPolygonUnion(const std::vector<std::vector<glm::vec2>>& polygons, PolyTreeD& output);
 
+/**
+ * @brief Finds the union of polygons that are already in Clipper form, e.g. the result of earlier unions.
+ *
+ * Holes must be wound opposite to their outer boundary, as Clipper produces them.
+ *
+ * @param polygons The polygons to merge.
+ * @param output A PolyTreeD object to store the resulting union.
+ * @return true if the union operation was successful, false otherwise.
+ */
+bool findPolygonUnion(const PathsD& polygons, PolyTreeD& output);
+
 /**
  * @brief Flattens a hierarchical PolyPathD into a simple PathsD structure.
  *
@@ -27,15 +39,64 @@ bool findPolygonUnion(const std::vector<std::vector<glm::vec2>>& polygons, PolyT
  */
 PathsD FlattenPolyPathD(const PolyPathD& polyPath);
 
+/**
+ * @brief Uniform grid over a set of line segments for finding the closest segment hit along a line.
+ *
+ * Each query only visits the cells the line passes through, front to back, and stops as soon as no unvisited cell
+ * can hold a closer hit. Results are identical to testing every segment: same distance filter, and ties go to the
+ * segment that comes first in the input.
+ */
+class SegmentGrid {
+public:
+   // Keeps its own copy of the segments, so the grid can outlive the list it was built from
+   explicit SegmentGrid(std::vector<std::array<glm::vec2, 2>> segments);
+
+   /**
+    * @brief Closest intersection of the segment start-end with any segment, ignoring hits within 0.1 of start.
+    */
+   std::optional<glm::vec2> ClosestSegmentHit(const glm::vec2& start, const glm::vec2& end) const;
+
+   /**
+    * @brief Closest intersection of the ray from origin along (dx, dy) with any segment, ignoring hits within 0.1 of
+    * origin.
+    */
+   std::optional<glm::vec2> ClosestRayHit(const glm::vec2& origin, double dx, double dy) const;
+
+private:
+   template <typename Intersect>
+   std::optional<glm::vec2> closestHit(const glm::vec2& start, double dx, double dy, double tEnd,
+                                       Intersect&& intersect) const;
+
+   std::vector<std::array<glm::vec2, 2>> segments;
+   glm::dvec2                            origin;
+   double                                cellSize = 1.0;
+   int                                   columns  = 0;
+   int                                   rows     = 0;
+   std::vector<uint32_t>                 cellStart; // segments of cell i are cellSegments[cellStart[i]..[i+1])
+   std::vector<uint32_t>                 cellSegments;
+   mutable std::vector<uint32_t>         visitedStamp;
+   mutable uint32_t                      currentStamp = 0;
+};
+
 /**
  * @brief Computes the visibility polygon from a given position and obstacles.
  *
+ * Occlusion tests go through a SegmentGrid, so this scales with the number of edges near each sight line rather than
+ * with every edge of the map.
+ *
  * @param position The player's position as glm::vec2.
  * @param obstacles The obstacles represented as PathsD (vector of paths).
  * @return PathD The visibility polygon as a vector of points.
  */
 PathD ComputeVisibilityPolygon(const glm::vec2& position, const PathsD& obstacles);
 
+/**
+ * @brief Reference version of ComputeVisibilityPolygon that tests every obstruction edge for every vertex (O(V*E)).
+ *
+ * Produces the same polygon; kept to verify and benchmark the grid accelerated version against.
+ */
+PathD ComputeVisibilityPolygonBruteForce(const glm::vec2& position, const PathsD& obstacles);
+
 /**
  * @brief Computes the intersection point between a ray and a line segment.
  *
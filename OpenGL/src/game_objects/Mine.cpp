@@ -11,9 +11,7 @@ Mine::Mine(const std::string& name, float x, float y)
 void Mine::tickUpdate() {
    // Explode the Mine
 
-   auto nearbyCharacters = World::where<Character>([&](const Character& character) {
-      return (std::abs(tile_x - character.tile_x) + std::abs(tile_y - character.tile_y) < 3);
-   });
+   auto nearbyCharacters = World::nearby<Character>(tile_x, tile_y, 3);
    if (!nearbyCharacters.empty() || detectedCharacter) {
       detectedCharacter = true;
       ExplodeTick++;
@@ -29,7 +27,7 @@ void Mine::tickUpdate() {
          audio().Bomb_Tick.play();
          red_last_frame = false;
       }
-      if (ExplodeTick > 6) {
+      if (ExplodeTick > FUSE_TICKS) {
          explode();
       }
    }
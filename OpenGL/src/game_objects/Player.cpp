@@ -9,9 +9,10 @@
 
 Player::Player(const std::string& name, int tile_x, int tile_y)
    : Character(name, tile_x, tile_y, "textures/alternate-player.png") {
-   drawPriority     = DrawPriority::Character;
-   health           = 5;
-   Camera::position = {tile_x, tile_y};
+   drawPriority             = DrawPriority::Character;
+   health                   = 5;
+   Camera::position         = {tile_x, tile_y};
+   Camera::previousPosition = Camera::position;
 
    healthText = std::make_unique<Text>("Health", Renderer::jacquard12_big, glm::vec2{20, 20});
    // topText = std::make_unique<Text>("Hello!", Renderer::Pixelify, glm::vec2{1280,650});
@@ -35,7 +36,7 @@ void Player::update() {
    Character::update();
 
    if (kicking) {
-      if (auto kickedGuy = kicking->victim.lock()) {
+      if (auto kickedGuy = World::resolve<Entity>(kicking->victim)) {
          if (glm::length(kickedGuy->position - position) < 1.5) {
             kickedGuy->kick(kicking->intoWall, kicking->direction.x, kicking->direction.y);
             World::timeSpeed = 0.1f;
@@ -44,12 +45,16 @@ void Player::update() {
          } else {
             std::cout << "kickedGuy->position - position " << glm::length(kickedGuy->position - position) << std::endl;
          }
+      } else {
+         // the victim died mid-kick (say to a bomb); without this, ticks would stay paused for good
+         kicking.reset();
       }
    }
 
    // smooth camera movement
-   Camera::position = zeno(Camera::position, position, 0.1);
-   tintColor.a      = zeno(tintColor.a, 0.0, 0.1);
+   Camera::previousPosition = Camera::position;
+   Camera::position         = zeno(Camera::position, position, 0.1);
+   tintColor.a              = zeno(tintColor.a, 0.0, 0.1);
 
    bool key_pressed_this_frame = false;
 
@@ -80,20 +85,29 @@ void Player::update() {
    healthText->name = "Health: " + std::to_string(health);
 
    // When user clicks the mouse,
+   aim();
 }
 
 void Player::render(Renderer& renderer) {
    Character::render(renderer);
+   if (zapped || (Input::right_mouse_pressed && hasSlomo)) {
+      Renderer::DebugLine(position, renderer.MousePos(), {1, 0, 0, 1});
+      zapped = false;
+   }
+}
+
+void Player::aim() {
+   glm::vec2 mouse = Input::mouseWorldPosition;
    if (Input::left_mouse_pressed_down) {
       if (gunCooldown == 0) {
-         Renderer::DebugLine(position, renderer.MousePos(), {1, 0, 0, 1});
+         zapped = true;
          audio().Zap.play();
          // get what is at mouse position
-         for (auto& character : World::at<Character>(renderer.MousePos().x + 0.5, renderer.MousePos().y + 0.5)) {
+         for (auto& character : World::at<Character>(mouse.x + 0.5, mouse.y + 0.5)) {
             character->stunnedLength = 6;
             character->tintColor     = {1.0, 0.5, 0.0, 0.5};
          }
-         for (auto& bomb : World::at<Bomb>(renderer.MousePos().x + 0.5, renderer.MousePos().y + 0.5)) {
+         for (auto& bomb : World::at<Bomb>(mouse.x + 0.5, mouse.y + 0.5)) {
             bomb->explode();
          }
          gunCooldown = playerGunCooldown;
@@ -101,12 +115,11 @@ void Player::render(Renderer& renderer) {
    }
    if (Input::right_mouse_pressed) {
       if (hasSlomo) {
-         Renderer::DebugLine(position, renderer.MousePos(), {1, 0, 0, 1});
          // get what is at mouse position
-         for (auto& character : World::at<Character>(renderer.MousePos().x + 0.5, renderer.MousePos().y + 0.5)) {
+         for (auto& character : World::at<Character>(mouse.x + 0.5, mouse.y + 0.5)) {
             character->tintColor = {1.0, 0.5, 0.0, 0.5};
          }
-         for (auto& bomb : World::at<Bomb>(renderer.MousePos().x + 0.5, renderer.MousePos().y + 0.5)) {
+         for (auto& bomb : World::at<Bomb>(mouse.x + 0.5, mouse.y + 0.5)) {
             bomb->tintColor = {1.0, 0.5, 0.0, 0.5};
          }
          World::timeSpeed        = zeno(World::timeSpeed, 0.333, 0.08);
@@ -201,7 +214,7 @@ void Player::tickUpdate() {
    }
 
    if (health == 1) {
-      if (std::fmod(glfwGetTime(), 0.3) < 0.15) {
+      if (std::fmod(Input::currentTime, 0.3) < 0.15) {
          tintColor = {0.5, 0.8, 0.5, 0.5};
       } else {
          tintColor = {0.75, 0.75, 0.0, 0.5};
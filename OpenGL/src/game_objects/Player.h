@@ -25,4 +25,11 @@ public:
    int  playerBunnyHopCoolDown = 6;
    int  playerGunCooldown      = 3;
    bool hasSlomo               = true;
+
+private:
+   // Zaps and slow motion, aimed at Input::mouseWorldPosition. Runs in update rather than render so that the
+   // simulation doesn't depend on what gets drawn, and replays headlessly.
+   void aim();
+   // Draw the zap on the next frame
+   bool zapped = false;
 };
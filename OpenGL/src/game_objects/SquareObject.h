@@ -9,7 +9,9 @@ public:
    SquareObject(const std::string& name, DrawPriority drawPriority, int tile_x, int tile_y, std::string texturePath);
    virtual void render(Renderer& renderer) override;
    virtual void update() override;
-   virtual void setUpShader(Renderer& renderer) override;
+   // Moves the object to a new tile. Always go through this instead of writing tile_x/tile_y directly so the World's
+   // spatial index stays in sync.
+   void         setTile(int x, int y);
    glm::vec4    tintColor = glm::vec4(0.0f);
    int          tile_x    = 0;
    int          tile_y    = 0;
@@ -1,21 +1,27 @@
 #include "Tile.h"
+#include "../World.h"
 
 Tile::Tile(const std::string& name, bool wall, bool unbreakable, float x, float y)
    : SquareObject(name, DrawPriority::Floor, x, y, "textures/alt-wall-bright.png")
    , wall(wall)
    , unbreakable(unbreakable) {
-   wallTextureUnbreakable = Texture::create(Renderer::ResPath() + "textures/alt-wall-unbreakable.png");
-   wallTexture            = Texture::create(Renderer::ResPath() + "textures/alt-wall-bright.png");
-
    // floor textures array
    std::vector<std::string> floorTextures = {"textures/2-alt-floor.png", "textures/2-alt-floor-2.png"};
 
+   // randomly select the texture. Drawn even without textures so headless replays use World::rng the same way.
+   size_t floorVariant = World::rng() % floorTextures.size();
+   if (World::headless) {
+      return;
+   }
+
+   wallTextureUnbreakable = Texture::create(Renderer::ResPath() + "textures/alt-wall-unbreakable.png");
+   wallTexture            = Texture::create(Renderer::ResPath() + "textures/alt-wall-bright.png");
+
    // alternate floor textures i made. I'm going to leave them here for convenience, just comment out the above line and
    // uncomment this one std::vector<std::string> floorTextures = {"Textures/alt-floor.png", "Textures/alt-floor-2.png",
    //                                          "Textures/alt-floor-2.png", "Textures/alt-floor-3.png"};
 
-   // randomly select the texture
-   floorTexture = Texture::create(Renderer::ResPath() + floorTextures[rand() % floorTextures.size()]);
+   floorTexture = Texture::create(Renderer::ResPath() + floorTextures[floorVariant]);
 
 
    setTexture();
@@ -24,8 +30,17 @@ Tile::Tile(const std::string& name, bool wall, bool unbreakable, float x, float
 Tile::Tile(const std::string& name, float x, float y)
    : Tile(name, false, true, x, y) {}
 
+Tile::~Tile() {
+   if (tileLayerSlot != UINT32_MAX) {
+      World::releasedTileSlots.push_back(tileLayerSlot);
+   }
+}
+
 void Tile::explode() {
    if (!unbreakable || !wall) {
+      if (wall) {
+         World::wallChanges.Push({tile_x, tile_y});
+      }
       tintColor = {0.8, 0.5, 0.5, 0.9};
       wall      = false;
    }
@@ -51,6 +66,19 @@ void Tile::update() {
    setTexture();
 }
 
+void Tile::render(Renderer& renderer) {
+   // Nothing to draw until the texture has been decoded
+   if (texture && !texture->IsReady()) {
+      return;
+   }
+   // Tiles never rotate or scale, which is all the instanced layer leaves out
+   if (texture && rotation == 0 && scale == 1.0f &&
+       renderer.tiles.Submit(tileLayerSlot, texture->GetRendererID(), {position, texture->GetUV(), tintColor})) {
+      return;
+   }
+   SquareObject::render(renderer);
+}
+
 void Tile::setTexture() {
    if (wall) {
       if (unbreakable) {
@@ -6,11 +6,16 @@ class Tile : public SquareObject {
 public:
    Tile(const std::string& name, bool wall, bool unbreakable, float x, float y);
    Tile(const std::string& name, float x, float y);
+   Tile(Tile&&) = default;
+   // Hands the tile's instance slot back to Renderer::tiles
+   ~Tile() override;
    virtual void           update() override;
+   virtual void           render(Renderer& renderer) override;
    virtual void           explode();
    std::vector<glm::vec2> getBounds();
    bool                   wall;
-   bool                   unbreakable = false;
+   bool                   unbreakable   = false;
+   uint32_t               tileLayerSlot = UINT32_MAX; // instance slot in Renderer::tiles
 
 
 private:
@@ -7,21 +7,16 @@ Bomber::Bomber(const std::string& name, float x, float y)
 }
 
 bool Bomber::move(int new_x, int new_y) {
-
-   auto nearbyBombsCurrent = World::where<Bomb>(
-      [&](const Bomb& bomb) { return (std::abs(tile_x - bomb.tile_x) + std::abs(tile_y - bomb.tile_y) < 3); });
-   auto nearbyBombsNew = World::where<Bomb>(
-      [&](const Bomb& bomb) { return (std::abs(new_x - bomb.tile_x) + std::abs(new_y - bomb.tile_y) < 3); });
-   if (nearbyBombsNew.empty() || !nearbyBombsCurrent.empty()) {
+   // Never walk into danger, but do walk around in it while trying to get out
+   bool inDanger = World::danger.IsDangerous(tile_x, tile_y);
+   if (!World::danger.IsDangerous(new_x, new_y) || inDanger) {
       Character::move(new_x, new_y);
    }
-   if (nearbyBombsCurrent.empty()) {
+   if (!inDanger) {
       for (auto& tile : World::at<Tile>(new_x, new_y)) {
          if (tile->wall) {
             // Check for nearby players
-            auto nearbyPlayers = World::where<Player>([&](const Player& player) {
-               return (std::abs(tile_x - player.tile_x) + std::abs(tile_y - player.tile_y) < 14);
-            });
+            auto nearbyPlayers = World::nearby<Player>(tile_x, tile_y, 14);
             if (!nearbyPlayers.empty()) {
                auto player = nearbyPlayers[0];
                World::gameobjectstoadd.push_back(std::make_unique<Bomb>(Bomb("CoolBomb", tile_x, tile_y)));
@@ -36,6 +31,43 @@ bool Bomber::move(int new_x, int new_y) {
    return false;
 }
 
+void Bomber::planFlee() {
+   // Each step goes to the neighbouring tile that is hit last (or never)
+   glm::ivec2 at(tile_x, tile_y);
+   while (plannedStepCount < 2 && World::danger.IsDangerous(at.x, at.y)) {
+      glm::ivec2 best(0);
+      uint8_t    bestTicks = World::danger.TicksUntilHit(at.x, at.y);
+      for (glm::ivec2 step : {glm::ivec2(1, 0), glm::ivec2(-1, 0), glm::ivec2(0, 1), glm::ivec2(0, -1)}) {
+         bool blocked = false;
+         for (auto& tile : World::at<Tile>(at.x + step.x, at.y + step.y)) {
+            blocked |= tile->wall;
+         }
+         uint8_t ticks = World::danger.TicksUntilHit(at.x + step.x, at.y + step.y);
+         if (!blocked && ticks > bestTicks) {
+            best      = step;
+            bestTicks = ticks;
+         }
+      }
+      if (best == glm::ivec2(0)) {
+         break;
+      }
+      plannedSteps[plannedStepCount++] = best;
+      at += best;
+   }
+}
+
+void Bomber::planChase() {
+   glm::ivec2 at(tile_x, tile_y);
+   while (plannedStepCount < 2) {
+      glm::ivec2 step = World::flowField.NextStep(at.x, at.y);
+      if (step == glm::ivec2(0)) {
+         break;
+      }
+      plannedSteps[plannedStepCount++] = step;
+      at += step;
+   }
+}
+
 void Bomber::update() {
    Character::update();
    tintColor.a = zeno(tintColor.a, 0.0, 0.1);
@@ -45,51 +77,49 @@ void Bomber::update() {
    }
 }
 
-void Bomber::tickUpdate() {
-
-   // Check for nearby players
-   auto nearbyPlayers = World::where<Player>(
-      [&](const Player& player) { return (std::abs(tile_x - player.tile_x) + std::abs(tile_y - player.tile_y) < 14); });
+void Bomber::decide() {
+   plannedStepCount = 0;
+   fleeing          = false;
+   chaseTarget      = {};
 
-   // Check for nearby bombs
-   auto nearbyBombs = World::where<Bomb>(
-      [&](const Bomb& bomb) { return (std::abs(tile_x - bomb.tile_x) + std::abs(tile_y - bomb.tile_y) < 3); });
-   auto nearbyBullets = World::where<Bullet>(
-      [&](const Bullet& bullet) { return (std::abs(tile_x - bullet.tile_x) + std::abs(tile_y - bullet.tile_y) < 3); });
+   // Get out of blast radii and bullet paths first
+   if (World::danger.IsDangerous(tile_x, tile_y)) {
+      fleeing = true;
+      planFlee();
+      return;
+   }
 
-   // Move to player
-   if (!nearbyBombs.empty()) {
-      auto bomb = nearbyBombs[0];
-      // Move away from bomb
-      move(tile_x + (tile_x > bomb->tile_x ? 1 : -1), tile_y);
-      move(tile_x, tile_y + (tile_y > bomb->tile_y ? 1 : -1));
+   // Check for nearby players
+   auto nearbyPlayers = World::nearby<Player>(tile_x, tile_y, 14);
+   if (!nearbyPlayers.empty()) {
+      chaseTarget = nearbyPlayers[0]->handle;
+      // Two steps along the shared flow field, which walks around walls. Only when the player is walled off from
+      // it does the bomber head straight at them, bombing its way through.
+      planChase();
    }
-   if (!nearbyBullets.empty()) {
-      auto bullet = nearbyBullets[0];
-      // Move away from bullet
+}
 
-      if (bullet->direction_x + bullet->tile_x == tile_x && bullet->direction_y + bullet->tile_y == tile_y) {
-         if (bullet->direction_x != 0) {
-            move(tile_x, tile_y + (tile_y > bullet->tile_y ? 1 : -1));
-         } else {
-            move(tile_x + (tile_x > bullet->tile_x ? 1 : -1), tile_y);
-         }
-      }
+void Bomber::tickUpdate() {
+   for (int i = 0; i < plannedStepCount; i++) {
+      move(tile_x + plannedSteps[i].x, tile_y + plannedSteps[i].y);
+   }
+   auto player = World::resolve<Player>(chaseTarget);
+   if (fleeing || !player) {
+      return;
    }
 
-   else if (!nearbyPlayers.empty() && nearbyBombs.empty()) {
-      auto player = nearbyPlayers[0];
+   if (plannedStepCount == 0) {
       move(tile_x + sign(player->tile_x - tile_x), tile_y);
       move(tile_x, tile_y + sign(player->tile_y - tile_y));
+   }
 
-      if (std::abs(tile_x - player->tile_x) + std::abs(tile_y - player->tile_y) < 2) {
-         // Drop a bomb
-         World::gameobjectstoadd.push_back(std::make_unique<Bomb>(Bomb("CoolBomb", tile_x, tile_y)));
-         audio().Bomb_Place.play();
+   if (std::abs(tile_x - player->tile_x) + std::abs(tile_y - player->tile_y) < 2) {
+      // Drop a bomb
+      World::gameobjectstoadd.push_back(std::make_unique<Bomb>(Bomb("CoolBomb", tile_x, tile_y)));
+      audio().Bomb_Place.play();
 
-         // Move away from player after dropping bomb
-         move(tile_x - sign(player->tile_x - tile_x), tile_y);
-         move(tile_x, tile_y - sign(player->tile_y - tile_y));
-      }
+      // Move away from player after dropping bomb
+      move(tile_x - sign(player->tile_x - tile_x), tile_y);
+      move(tile_x, tile_y - sign(player->tile_y - tile_y));
    }
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include "../Character.h"
 #include "../Player.h"
 #include "../../World.h"
@@ -9,6 +10,20 @@ class Bomber : public Character {
 public:
    Bomber(const std::string& name, float x, float y);
    virtual void update() override;
+   virtual void decide() override;
    virtual void tickUpdate() override;
    virtual bool move(int new_x, int new_y) override;
+
+private:
+   // Plans up to two steps away from the tiles in World::danger
+   void planFlee();
+   // Plans up to two steps along World::flowField
+   void planChase();
+
+   // Intent, written by decide and carried out by tickUpdate
+   std::array<glm::ivec2, 2> plannedSteps     = {};
+   int                       plannedStepCount = 0;
+   bool                      fleeing          = false;
+   // The player being chased, if any. Without planned steps the bomber heads straight at them.
+   EntityHandle              chaseTarget;
 };
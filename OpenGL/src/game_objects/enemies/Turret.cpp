@@ -13,6 +13,33 @@ void Turret::update() {
    }
 }
 
+void Turret::decide() {
+   sighted = glm::ivec2(0);
+
+   // Find nearby players without modifying anything but the sighting
+   auto nearbyPlayers = World::where<Player>([&](const Player& player) -> bool {
+      // Check horizontal proximity
+      if (std::abs(tile_x - player.tile_x) <= 10 && tile_y == player.tile_y) {
+         return true;
+      }
+      // Check vertical proximity
+      if (std::abs(tile_y - player.tile_y) <= 10 && tile_x == player.tile_x) {
+         return true;
+      }
+      return false;
+   });
+
+   // Assuming you handle one player at a time
+   if (!nearbyPlayers.empty()) {
+      const Player& player = *nearbyPlayers[0];
+      if (tile_y == player.tile_y) {
+         sighted = glm::ivec2((player.tile_x > tile_x) ? 1 : -1, 0);
+      } else {
+         sighted = glm::ivec2(0, (player.tile_y > tile_y) ? 1 : -1);
+      }
+   }
+}
+
 void Turret::tickUpdate() {
    if (stunnedLength == 0) {
       if (shot_last_tick) {
@@ -21,42 +48,11 @@ void Turret::tickUpdate() {
       }
       shot_last_tick = true;
 
-      // Find nearby players without modifying the turret's state
-      auto nearbyPlayers = World::where<Player>([&](const Player& player) -> bool {
-         // Check horizontal proximity
-         if (std::abs(tile_x - player.tile_x) <= 10 && tile_y == player.tile_y) {
-            return true;
-         }
-         // Check vertical proximity
-         if (std::abs(tile_y - player.tile_y) <= 10 && tile_x == player.tile_x) {
-            return true;
-         }
-         return false;
-      });
-
-      bool playerDetected = false;
-
-      // Process nearby players to set aim direction and bullets to shoot
-      for (const auto& playerPtr : nearbyPlayers) {
-         const Player& player = *playerPtr;
-
-         // Check horizontal proximity
-         if (std::abs(tile_x - player.tile_x) <= 10 && tile_y == player.tile_y) {
-            aimDirection_x = (player.tile_x > tile_x) ? 1 : -1;
-            aimDirection_y = 0;
-            bulletsToShoot = 3;
-            playerDetected = true;
-            break; // Assuming you handle one player at a time
-         }
-
-         // Check vertical proximity
-         if (std::abs(tile_y - player.tile_y) <= 10 && tile_x == player.tile_x) {
-            aimDirection_y = (player.tile_y > tile_y) ? 1 : -1;
-            aimDirection_x = 0;
-            bulletsToShoot = 3;
-            playerDetected = true;
-            break; // Assuming you handle one player at a time
-         }
+      // Aim at a player spotted this tick
+      if (sighted != glm::ivec2(0)) {
+         aimDirection_x = sighted.x;
+         aimDirection_y = sighted.y;
+         bulletsToShoot = 3;
       }
 
       // If a player was detected, shoot a bullet
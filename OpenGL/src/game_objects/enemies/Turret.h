@@ -8,9 +8,12 @@ class Turret : public Character {
 public:
    Turret(const std::string& name, float x, float y);
    virtual void update() override;
+   virtual void decide() override;
    virtual void tickUpdate() override;
    int          aimDirection_x = 0;
    int          aimDirection_y = 0;
    int          bulletsToShoot = 0;
    bool         shot_last_tick = false;
+   // Written by decide: the direction of a player in line of fire, or zero
+   glm::ivec2   sighted        = glm::ivec2(0);
 };
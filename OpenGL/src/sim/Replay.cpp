@@ -0,0 +1,94 @@
+// Headless playback of a session recorded with `SpaceBoom --record <file>`. Feeds the recorded input back one fixed
+// step at a time and checks that the world ends up in the state the recording ended in. Reports the slowest steps, so
+// a recorded frame spike can be reproduced and profiled without a window or GPU.
+//
+// usage: SpaceBoomReplay <recording> [threads]
+//    recording  file written by SpaceBoom --record
+//    threads    threads for the decide phase of each tick (default 0, one per hardware thread)
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FixedClock.h"
+#include "Input.h"
+#include "InputRecording.h"
+#include "World.h"
+#include "game_objects/Player.h"
+
+namespace {
+
+// how many of the slowest steps to list
+const size_t SLOWEST_STEPS = 5;
+
+} // namespace
+
+int main(int argc, char** argv) {
+   if (argc < 2) {
+      std::cerr << "usage: SpaceBoomReplay <recording> [threads]" << std::endl;
+      return 2;
+   }
+   auto recording = Recording::Load(argv[1]);
+   if (!recording) {
+      return 2;
+   }
+
+   World::headless    = true;
+   World::tickThreads = argc > 2 ? (unsigned)std::atol(argv[2]) : 0;
+   World::rng.seed(recording->seed);
+   World::LoadMap(recording->map);
+
+   if (!World::getFirst<Player>()) {
+      std::cerr << "Map " << recording->map << " has no player" << std::endl;
+      return 2;
+   }
+
+   Input::deltaTime   = (float)FixedClock::STEP;
+   Input::currentTime = Input::startTime;
+
+   // (milliseconds, step)
+   std::vector<std::pair<double, size_t>> stepTimes;
+   stepTimes.reserve(recording->steps.size());
+   auto replayStart = std::chrono::steady_clock::now();
+   for (size_t i = 0; i < recording->steps.size(); ++i) {
+      Recording::Apply(recording->steps[i]);
+      auto stepStart = std::chrono::steady_clock::now();
+      World::Step();
+      auto stepEnd = std::chrono::steady_clock::now();
+      stepTimes.push_back({std::chrono::duration<double, std::milli>(stepEnd - stepStart).count(), i});
+   }
+   auto replayEnd = std::chrono::steady_clock::now();
+
+   uint64_t stateHash = World::StateHash();
+   bool     matches   = !recording->stateHash || *recording->stateHash == stateHash;
+
+   std::cout << "recording:     " << argv[1] << "\n"
+             << "map:           " << recording->map << "\n"
+             << "seed:          " << recording->seed << "\n"
+             << "steps:         " << recording->steps.size() << " ("
+             << recording->steps.size() * FixedClock::STEP << " s of play)\n"
+             << "replay time:   " << std::chrono::duration<double, std::milli>(replayEnd - replayStart).count()
+             << " ms\n";
+
+   size_t slowest = std::min(SLOWEST_STEPS, stepTimes.size());
+   std::partial_sort(stepTimes.begin(), stepTimes.begin() + slowest, stepTimes.end(), std::greater<>());
+   for (size_t i = 0; i < slowest; ++i) {
+      std::cout << "slow step:     " << stepTimes[i].second << " (" << stepTimes[i].second * FixedClock::STEP
+                << " s) took " << stepTimes[i].first << " ms\n";
+   }
+
+   std::cout << std::hex << "state hash:    " << stateHash << "\n";
+   if (recording->stateHash) {
+      std::cout << "recorded hash: " << *recording->stateHash << "\n";
+   } else {
+      std::cout << "recorded hash: none, the session did not exit cleanly\n";
+   }
+   std::cout << std::dec << (matches ? "replay matches the recording" : "replay DIVERGED from the recording")
+             << std::endl;
+   return matches ? 0 : 1;
+}
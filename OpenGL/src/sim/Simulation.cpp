@@ -0,0 +1,138 @@
+// Headless tick-only simulation of a map. Never creates a window or GL context, so it can run on machines without a
+// display or GPU and measure pure game-logic throughput.
+//
+// usage: SpaceBoomSim [map] [ticks] [script] [threads]
+//    map     map to load, relative to res/ (default maps/SpaceShip.txt)
+//    ticks   number of ticks to simulate (default 1000)
+//    script  input for each tick, one character per tick, repeated until the run ends. A character is held from one
+//            tick to the next through fixed steps (World::Step), the same way a player holds a key in the game:
+//               w/a/s/d  move      W/A/S/D  bunny hop      b  place bomb      .  do nothing
+//    threads threads for the decide phase of each tick (default 0, one per hardware thread); the outcome is the same
+//            for any count, which the printed state hash (World::StateHash) shows
+//
+// Exits with 1 if the run stalls: a tick doesn't come within a minute of game time, e.g. with ticks paused for good.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "FixedClock.h"
+#include "Input.h"
+#include "World.h"
+#include "game_objects/Player.h"
+
+namespace {
+
+// A tick that hasn't come after this many steps (a minute of game time) means the run is stuck with ticks paused
+const long MAX_STEPS_PER_TICK = 60 * FixedClock::STEPS_PER_SECOND;
+
+// Presses the keys for `c` and releases the rest, with keys_pressed_down set for the newly pressed ones like
+// Input::updateKeyStates does
+void applyScriptedInput(char c) {
+   static bool keysPressedBefore[GLFW_KEY_LAST] = {false};
+   std::copy(std::begin(Input::keys_pressed), std::end(Input::keys_pressed), std::begin(keysPressedBefore));
+   std::fill(std::begin(Input::keys_pressed), std::end(Input::keys_pressed), false);
+
+   switch (std::tolower(static_cast<unsigned char>(c))) {
+   case 'w':
+      Input::keys_pressed[GLFW_KEY_W] = true;
+      break;
+   case 'a':
+      Input::keys_pressed[GLFW_KEY_A] = true;
+      break;
+   case 's':
+      Input::keys_pressed[GLFW_KEY_S] = true;
+      break;
+   case 'd':
+      Input::keys_pressed[GLFW_KEY_D] = true;
+      break;
+   case 'b':
+      Input::keys_pressed[GLFW_KEY_SPACE] = true;
+      break;
+   default:
+      break;
+   }
+   if (std::isupper(static_cast<unsigned char>(c))) {
+      Input::keys_pressed[GLFW_KEY_LEFT_SHIFT] = true;
+   }
+   for (int key = 0; key < GLFW_KEY_LAST; ++key) {
+      Input::keys_pressed_down[key] = !keysPressedBefore[key] && Input::keys_pressed[key];
+   }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   std::string map     = argc > 1 ? argv[1] : "maps/SpaceShip.txt";
+   long        ticks   = argc > 2 ? std::atol(argv[2]) : 1000;
+   std::string script  = argc > 3 ? argv[3] : "ddwwbaassb";
+   unsigned    threads = argc > 4 ? (unsigned)std::atol(argv[4]) : 0;
+   if (script.empty()) {
+      script = ".";
+   }
+
+   World::headless    = true;
+   World::tickThreads = threads;
+
+   auto loadStart = std::chrono::steady_clock::now();
+   World::LoadMap(map);
+   auto loadEnd = std::chrono::steady_clock::now();
+
+   if (!World::getFirst<Player>()) {
+      std::cerr << "Map " << map << " has no player" << std::endl;
+      return 1;
+   }
+
+   Input::currentTime = Input::startTime;
+   Input::deltaTime   = (float)FixedClock::STEP;
+
+   long ticksDone   = 0;
+   long steps       = 0;
+   long pausedSteps = 0;
+   bool stalled     = false;
+   auto simStart    = std::chrono::steady_clock::now();
+   while (ticksDone < ticks && !stalled) {
+      applyScriptedInput(script[ticksDone % script.size()]);
+      for (long stepsThisTick = 1;; ++stepsThisTick) {
+         steps++;
+         if (World::Step()) {
+            ticksDone++;
+            break;
+         }
+         if (World::ticksPaused()) {
+            pausedSteps++;
+         }
+         if (stepsThisTick >= MAX_STEPS_PER_TICK) {
+            stalled = true;
+            break;
+         }
+         // Only the first step sees the presses, as in Application's frame loop
+         Input::clearPressedDown();
+      }
+   }
+   auto simEnd = std::chrono::steady_clock::now();
+
+   double loadSeconds = std::chrono::duration<double>(loadEnd - loadStart).count();
+   double simSeconds  = std::chrono::duration<double>(simEnd - simStart).count();
+   auto   player      = World::getFirst<Player>();
+
+   std::cout << "map:           " << map << "\n"
+             << "objects:       " << World::gameobjects.size() << "\n"
+             << "load time:     " << loadSeconds * 1000.0 << " ms\n"
+             << "threads:       " << (threads ? std::to_string(threads) : "auto") << "\n"
+             << "ticks:         " << ticksDone << " (" << steps << " steps, " << pausedSteps << " paused)\n"
+             << "sim time:      " << simSeconds * 1000.0 << " ms\n"
+             << "ticks/second:  " << (simSeconds > 0 ? ticksDone / simSeconds : 0.0) << "\n"
+             << "player:        (" << player->tile_x << ", " << player->tile_y << ") health " << player->health
+             << "\n"
+             << "state hash:    " << std::hex << World::StateHash() << std::dec << std::endl;
+   if (stalled) {
+      std::cerr << "Stalled after " << ticksDone << " of " << ticks << " ticks: no tick in " << MAX_STEPS_PER_TICK
+                << " steps" << std::endl;
+      return 1;
+   }
+   return 0;
+}
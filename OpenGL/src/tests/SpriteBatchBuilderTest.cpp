@@ -0,0 +1,120 @@
+// Headless checks of SpriteBatchBuilder, the CPU half of the sprite batch. Needs no window or GL context.
+//
+// usage: SpriteBatchBuilderTest
+//    prints every failed check and exits with 1 if there was one
+
+#include <cmath>
+#include <iostream>
+
+#include "SpriteBatchBuilder.h"
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                                                               \
+   do {                                                                                                                \
+      if (!(condition)) {                                                                                              \
+         std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;                       \
+         failures++;                                                                                                   \
+      }                                                                                                                \
+   } while (false)
+
+Sprite sprite(uint32_t texture, glm::vec2 position) {
+   return {texture, position, 0.0f, 1.0f, glm::vec4(1.0f)};
+}
+
+bool near(glm::vec2 a, glm::vec2 b) {
+   return std::abs(a.x - b.x) < 1e-5f && std::abs(a.y - b.y) < 1e-5f;
+}
+
+// Sprites sharing a texture go into one run, and their quads come out in submission order
+void batchesOneTexture() {
+   SpriteBatchBuilder builder;
+   for (int i = 0; i < 100; i++) {
+      builder.Submit(sprite(7, {(float)i, 0.0f}));
+   }
+   builder.Build();
+
+   CHECK(builder.Runs().size() == 1);
+   CHECK(builder.Runs()[0].texture == 7);
+   CHECK(builder.Runs()[0].firstSprite == 0);
+   CHECK(builder.Runs()[0].spriteCount == 100);
+   CHECK(builder.Vertices().size() == 400);
+   for (int i = 0; i < 100; i++) {
+      CHECK(near(builder.Vertices()[i * 4].position, {i - 0.5f, -0.5f}));
+   }
+}
+
+// A texture change starts a new run, and sprites are never moved past one of another texture: a sprite on top of
+// another still comes later in the vertex buffer
+void breaksRunsAtTextureChanges() {
+   SpriteBatchBuilder builder;
+   builder.Submit(sprite(1, {0.0f, 0.0f}));
+   builder.Submit(sprite(1, {1.0f, 0.0f}));
+   builder.Submit(sprite(2, {0.0f, 0.0f}));
+   builder.Submit(sprite(1, {0.0f, 0.0f}));
+   builder.Build();
+
+   const auto& runs = builder.Runs();
+   CHECK(runs.size() == 3);
+   if (runs.size() == 3) {
+      CHECK(runs[0].texture == 1 && runs[0].firstSprite == 0 && runs[0].spriteCount == 2);
+      CHECK(runs[1].texture == 2 && runs[1].firstSprite == 2 && runs[1].spriteCount == 1);
+      CHECK(runs[2].texture == 1 && runs[2].firstSprite == 3 && runs[2].spriteCount == 1);
+   }
+}
+
+// Each draw layer is built and cleared on its own, so nothing of one layer leaks into the next
+void keepsLayersApart() {
+   SpriteBatchBuilder builder;
+   builder.Submit(sprite(1, {0.0f, 0.0f}));
+   builder.Submit(sprite(2, {0.0f, 0.0f}));
+   builder.Build();
+   CHECK(builder.Runs().size() == 2);
+   builder.Clear();
+   CHECK(builder.Empty());
+
+   builder.Submit(sprite(2, {5.0f, 5.0f}));
+   builder.Build();
+   CHECK(builder.SpriteCount() == 1);
+   CHECK(builder.Runs().size() == 1);
+   CHECK(builder.Runs()[0].texture == 2);
+   CHECK(builder.Vertices().size() == 4);
+   CHECK(near(builder.Vertices()[0].position, {4.5f, 4.5f}));
+}
+
+// Corners follow the model transform (translate * rotate * scale) and the uv sub-rectangle
+void expandsQuads() {
+   SpriteBatchBuilder builder;
+   Sprite rotated = sprite(1, {10.0f, 20.0f});
+   rotated.rotation = 90.0f;
+   rotated.scale    = 2.0f;
+   rotated.tint     = {1.0f, 0.0f, 0.0f, 0.5f};
+   rotated.uv       = {0.25f, 0.5f, 0.75f, 1.0f};
+   builder.Submit(rotated);
+   builder.Build();
+
+   const auto& vertices = builder.Vertices();
+   CHECK(near(vertices[0].position, {11.0f, 19.0f}));
+   CHECK(near(vertices[2].position, {9.0f, 21.0f}));
+   CHECK(near(vertices[0].texCoord, {0.25f, 0.5f}));
+   CHECK(near(vertices[2].texCoord, {0.75f, 1.0f}));
+   CHECK(vertices[3].tint == rotated.tint);
+}
+
+} // namespace
+
+int main() {
+   batchesOneTexture();
+   breaksRunsAtTextureChanges();
+   keepsLayersApart();
+   expandsQuads();
+
+   if (failures) {
+      std::cerr << failures << " check(s) failed" << std::endl;
+      return 1;
+   }
+   std::cout << "all checks passed" << std::endl;
+   return 0;
+}
@@ -0,0 +1,70 @@
+// Converts ASCII maps to the binary .sbm format read by World::LoadMap (see MapFile.h).
+//
+// usage: SpaceBoomMapConvert input.txt [output.sbm]
+//        SpaceBoomMapConvert --all DIRECTORY    converts every *.txt in DIRECTORY next to itself
+//
+// Without an output path the .sbm is written next to the input.
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "MapFile.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool convert(const fs::path& input, const fs::path& output) {
+   std::ifstream file(input);
+   if (!file.is_open()) {
+      std::cerr << "Error opening file: " << input << std::endl;
+      return false;
+   }
+   MapData map = MapFile::ParseText(file);
+   if (!MapFile::Write(map.view(), output.string())) {
+      std::cerr << "Error writing " << output << std::endl;
+      return false;
+   }
+
+   // Read it back through the same path the game uses
+   auto mapped = MappedMap::Open(output.string());
+   if (!mapped) {
+      std::cerr << "Wrote an unreadable map: " << output << std::endl;
+      return false;
+   }
+   auto view = mapped->view();
+   if (!std::equal(view.tiles.begin(), view.tiles.end(), map.tiles.begin(), map.tiles.end()) ||
+       view.spawns.size() != map.spawns.size()) {
+      std::cerr << "Map changed on the way to " << output << std::endl;
+      return false;
+   }
+
+   std::cout << input.string() << " -> " << output.string() << " (" << map.header.width << "x" << map.header.height
+             << ", " << map.spawns.size() << " spawns, " << fs::file_size(output) << " bytes)" << std::endl;
+   return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   if (argc == 3 && std::string(argv[1]) == "--all") {
+      bool ok = true;
+      for (const auto& entry : fs::directory_iterator(argv[2])) {
+         if (entry.path().extension() == ".txt") {
+            ok &= convert(entry.path(), fs::path(entry.path()).replace_extension(".sbm"));
+         }
+      }
+      return ok ? 0 : 1;
+   }
+   if (argc == 2 || argc == 3) {
+      fs::path input  = argv[1];
+      fs::path output = argc == 3 ? fs::path(argv[2]) : fs::path(input).replace_extension(".sbm");
+      return convert(input, output) ? 0 : 1;
+   }
+
+   std::cerr << "usage: SpaceBoomMapConvert input.txt [output.sbm]\n"
+             << "       SpaceBoomMapConvert --all DIRECTORY" << std::endl;
+   return 1;
+}
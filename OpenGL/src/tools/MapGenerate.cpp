@@ -0,0 +1,82 @@
+// Generates a seeded map for stress tests (see MapGenerator.h). The same arguments always produce the same map.
+//
+// usage: SpaceBoomMapGen [options] OUTPUT
+//    --size WxH        map size in tiles, up to 4096x4096 (default 128x128)
+//    --seed N          (default 1)
+//    --bombers D       expected bombers per floor tile (default 0.002)
+//    --turrets D       expected turrets per floor tile (default 0.001)
+//    --mines D         expected mines per floor tile (default 0.002)
+//
+// OUTPUT ending in .sbm is written in the binary format, anything else as an ASCII map for World::LoadMap.
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "MapGenerator.h"
+
+namespace {
+
+const uint32_t MAX_SIZE = 4096;
+
+int usage() {
+   std::cerr << "usage: SpaceBoomMapGen [--size WxH] [--seed N] [--bombers D] [--turrets D] [--mines D] OUTPUT"
+             << std::endl;
+   return 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   MapGeneratorOptions options;
+   std::string         outputPath;
+
+   for (int i = 1; i < argc; i++) {
+      std::string arg = argv[i];
+      if (arg == "--size" && i + 1 < argc) {
+         if (std::sscanf(argv[++i], "%ux%u", &options.width, &options.height) != 2) {
+            return usage();
+         }
+      } else if (arg == "--seed" && i + 1 < argc) {
+         options.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+      } else if (arg == "--bombers" && i + 1 < argc) {
+         options.bomberDensity = std::strtof(argv[++i], nullptr);
+      } else if (arg == "--turrets" && i + 1 < argc) {
+         options.turretDensity = std::strtof(argv[++i], nullptr);
+      } else if (arg == "--mines" && i + 1 < argc) {
+         options.mineDensity = std::strtof(argv[++i], nullptr);
+      } else if (outputPath.empty() && arg[0] != '-') {
+         outputPath = arg;
+      } else {
+         return usage();
+      }
+   }
+   if (outputPath.empty()) {
+      return usage();
+   }
+   if (options.width > MAX_SIZE || options.height > MAX_SIZE) {
+      std::cerr << "maps are limited to " << MAX_SIZE << "x" << MAX_SIZE << std::endl;
+      return 1;
+   }
+
+   MapData map = MapGenerator::Generate(options);
+
+   bool ok;
+   if (outputPath.ends_with(".sbm")) {
+      ok = MapFile::Write(map.view(), outputPath);
+   } else {
+      std::ofstream file(outputPath);
+      MapFile::WriteText(map.view(), file);
+      ok = file.good();
+   }
+   if (!ok) {
+      std::cerr << "Error writing " << outputPath << std::endl;
+      return 1;
+   }
+
+   std::cout << outputPath << ": " << map.header.width << "x" << map.header.height << ", seed " << options.seed << ", "
+             << map.spawns.size() << " spawns" << std::endl;
+   return 0;
+}